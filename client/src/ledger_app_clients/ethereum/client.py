@@ -75,6 +75,18 @@ class EthAppClient:
                           array_levels,
                           key_name))
 
+    def eip712_send_struct_defs(self, structs: dict[str, list[tuple]]):
+        # structs: name -> list of (field_type, type_name, type_size, array_levels, key_name)
+        entries = list()
+        for name, fields in structs.items():
+            entries.append(self._cmd_builder.eip712_struct_def_struct_name_entry(name))
+            for field in fields:
+                entries.append(self._cmd_builder.eip712_struct_def_struct_field_entry(*field))
+        chunks = self._cmd_builder.eip712_send_struct_def_batch(entries)
+        for chunk in chunks[:-1]:
+            self._exchange(chunk)
+        return self._exchange_async(chunks[-1])
+
     def eip712_send_struct_impl_root_struct(self, name: str):
         return self._exchange_async(self._cmd_builder.eip712_send_struct_impl_root_struct(name))
 
@@ -87,6 +99,10 @@ class EthAppClient:
             self._exchange(chunk)
         return self._exchange_async(chunks[-1])
 
+    def eip712_send_struct_impl_struct_fields(self, raw_values: list[bytes]):
+        return self._exchange_async(self._cmd_builder.eip712_send_struct_impl_struct_fields(
+            raw_values))
+
     def eip712_sign_new(self, bip32_path: str):
         return self._exchange_async(self._cmd_builder.eip712_sign_new(bip32_path))
 
@@ -101,10 +117,15 @@ class EthAppClient:
     def eip712_filtering_activate(self):
         return self._exchange_async(self._cmd_builder.eip712_filtering_activate())
 
-    def eip712_filtering_message_info(self, name: str, filters_count: int, sig: bytes):
+    def eip712_filtering_message_info(self,
+                                      name: str,
+                                      filters_count: int,
+                                      sig: bytes,
+                                      manifest_root: Optional[bytes] = None):
         return self._exchange_async(self._cmd_builder.eip712_filtering_message_info(name,
                                                                                     filters_count,
-                                                                                    sig))
+                                                                                    sig,
+                                                                                    manifest_root))
 
     def eip712_filtering_amount_join_token(self, token_idx: int, sig: bytes):
         return self._exchange_async(self._cmd_builder.eip712_filtering_amount_join_token(token_idx,
@@ -153,12 +174,38 @@ class EthAppClient:
                                                                       bip32_path,
                                                                       chain_id))
 
+    def get_public_addrs(self,
+                         bip32_path: str,
+                         first_index: int,
+                         count: int) -> list[RAPDU]:
+        responses = [self._exchange(self._cmd_builder.get_public_addr_batch_first(bip32_path,
+                                                                                  first_index,
+                                                                                  count))]
+        received = responses[-1].data[0]
+        while received < count:
+            responses.append(self._exchange(self._cmd_builder.get_public_addr_batch_next()))
+            received += responses[-1].data[0]
+        return responses
+
     def get_eth2_public_addr(self,
                              display: bool = True,
                              bip32_path: str = "m/12381/3600/0/0"):
         return self._exchange_async(self._cmd_builder.get_eth2_public_addr(display,
                                                                            bip32_path))
 
+    def get_eth2_public_addrs(self,
+                              bip32_path: str,
+                              level: int,
+                              count: int) -> list[RAPDU]:
+        responses = [self._exchange(self._cmd_builder.get_eth2_public_addr_batch_first(bip32_path,
+                                                                                       level,
+                                                                                       count))]
+        received = responses[-1].data[0]
+        while received < count:
+            responses.append(self._exchange(self._cmd_builder.get_eth2_public_addr_batch_next()))
+            received += responses[-1].data[0]
+        return responses
+
     def perform_privacy_operation(self,
                                   display: bool = True,
                                   bip32_path: str = "m/44'/60'/0'/0/0",
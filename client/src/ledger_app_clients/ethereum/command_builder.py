@@ -32,15 +32,20 @@ class P1Type(IntEnum):
     PARTIAL_SEND = 0x01
     SIGN_FIRST_CHUNK = 0x00
     SIGN_SUBSQT_CHUNK = 0x80
+    BATCH_FIRST = 0x02
+    BATCH_NEXT = 0x03
 
 
 class P2Type(IntEnum):
     STRUCT_NAME = 0x00
     STRUCT_FIELD = 0xff
+    STRUCT_FIELDS = 0xfe
+    STRUCT_DEF_BATCH = 0xfe
     ARRAY = 0x0f
     LEGACY_IMPLEM = 0x00
     NEW_IMPLEM = 0x01
     FILTERING_ACTIVATE = 0x00
+    FILTERING_MESSAGE_MANIFEST = 0x0e
     FILTERING_MESSAGE_INFO = 0x0f
     FILTERING_DATETIME = 0xfc
     FILTERING_TOKEN_ADDR_CHECK = 0xfd
@@ -71,12 +76,12 @@ class CommandBuilder:
                                P2Type.STRUCT_NAME,
                                name.encode())
 
-    def eip712_send_struct_def_struct_field(self,
-                                            field_type: EIP712FieldType,
-                                            type_name: str,
-                                            type_size: int,
-                                            array_levels: list,
-                                            key_name: str) -> bytes:
+    def _eip712_struct_def_field_data(self,
+                                      field_type: EIP712FieldType,
+                                      type_name: str,
+                                      type_size: int,
+                                      array_levels: list,
+                                      key_name: str) -> bytes:
         data = bytearray()
         typedesc = 0
         typedesc |= (len(array_levels) > 0) << 7
@@ -96,11 +101,66 @@ class CommandBuilder:
                     data.append(level)
         data.append(len(key_name))
         data += key_name.encode()
+        return data
+
+    def eip712_send_struct_def_struct_field(self,
+                                            field_type: EIP712FieldType,
+                                            type_name: str,
+                                            type_size: int,
+                                            array_levels: list,
+                                            key_name: str) -> bytes:
+        data = self._eip712_struct_def_field_data(field_type,
+                                                  type_name,
+                                                  type_size,
+                                                  array_levels,
+                                                  key_name)
         return self._serialize(InsType.EIP712_SEND_STRUCT_DEF,
                                P1Type.COMPLETE_SEND,
                                P2Type.STRUCT_FIELD,
                                data)
 
+    def eip712_struct_def_struct_name_entry(self, name: str) -> bytes:
+        data = bytearray()
+        data.append(P2Type.STRUCT_NAME)
+        data.append(len(name))
+        data += name.encode()
+        return data
+
+    def eip712_struct_def_struct_field_entry(self,
+                                             field_type: EIP712FieldType,
+                                             type_name: str,
+                                             type_size: int,
+                                             array_levels: list,
+                                             key_name: str) -> bytes:
+        field_data = self._eip712_struct_def_field_data(field_type,
+                                                        type_name,
+                                                        type_size,
+                                                        array_levels,
+                                                        key_name)
+        data = bytearray()
+        data.append(P2Type.STRUCT_FIELD)
+        data.append(len(field_data))
+        data += field_data
+        return data
+
+    def eip712_send_struct_def_batch(self, entries: list[bytes]) -> list[bytes]:
+        chunks = list()
+        data = bytearray()
+        for entry in entries:
+            if (len(data) + len(entry)) > 0xff:
+                chunks.append(self._serialize(InsType.EIP712_SEND_STRUCT_DEF,
+                                              P1Type.COMPLETE_SEND,
+                                              P2Type.STRUCT_DEF_BATCH,
+                                              data))
+                data = bytearray()
+            data += entry
+        if len(data) > 0:
+            chunks.append(self._serialize(InsType.EIP712_SEND_STRUCT_DEF,
+                                          P1Type.COMPLETE_SEND,
+                                          P2Type.STRUCT_DEF_BATCH,
+                                          data))
+        return chunks
+
     def eip712_send_struct_impl_root_struct(self, name: str) -> bytes:
         return self._serialize(InsType.EIP712_SEND_STRUCT_IMPL,
                                P1Type.COMPLETE_SEND,
@@ -131,6 +191,17 @@ class CommandBuilder:
             data_w_length = data_w_length[0xff:]
         return chunks
 
+    def eip712_send_struct_impl_struct_fields(self, values: list[bytes]) -> bytes:
+        data = bytearray()
+        for value in values:
+            # 16-bit integer with the value's byte length (network byte order)
+            data += struct.pack(">H", len(value))
+            data += value
+        return self._serialize(InsType.EIP712_SEND_STRUCT_IMPL,
+                               P1Type.COMPLETE_SEND,
+                               P2Type.STRUCT_FIELDS,
+                               data)
+
     def eip712_sign_new(self, bip32_path: str) -> bytes:
         data = pack_derivation_path(bip32_path)
         return self._serialize(InsType.EIP712_SIGN,
@@ -164,16 +235,23 @@ class CommandBuilder:
         data += sig
         return data
 
-    def eip712_filtering_message_info(self, name: str, filters_count: int, sig: bytes) -> bytes:
+    def eip712_filtering_message_info(self,
+                                      name: str,
+                                      filters_count: int,
+                                      sig: bytes,
+                                      manifest_root: Optional[bytes] = None) -> bytes:
         data = bytearray()
         data.append(len(name))
         data += name.encode()
         data.append(filters_count)
+        if manifest_root is not None:
+            data += manifest_root
         data.append(len(sig))
         data += sig
         return self._serialize(InsType.EIP712_SEND_FILTERING,
                                P1Type.COMPLETE_SEND,
-                               P2Type.FILTERING_MESSAGE_INFO,
+                               P2Type.FILTERING_MESSAGE_INFO if manifest_root is None
+                               else P2Type.FILTERING_MESSAGE_MANIFEST,
                                data)
 
     def eip712_filtering_amount_join_token(self, token_idx: int, sig: bytes) -> bytes:
@@ -277,6 +355,23 @@ class CommandBuilder:
                                int(chaincode),
                                payload)
 
+    def get_public_addr_batch_first(self,
+                                    bip32_path: str,
+                                    first_index: int,
+                                    count: int) -> bytes:
+        payload = pack_derivation_path(bip32_path)
+        payload += struct.pack(">IB", first_index, count)
+        return self._serialize(InsType.GET_PUBLIC_ADDR,
+                               P1Type.BATCH_FIRST,
+                               0x00,
+                               payload)
+
+    def get_public_addr_batch_next(self) -> bytes:
+        return self._serialize(InsType.GET_PUBLIC_ADDR,
+                               P1Type.BATCH_NEXT,
+                               0x00,
+                               bytes())
+
     def get_eth2_public_addr(self,
                              display: bool,
                              bip32_path: str) -> bytes:
@@ -286,6 +381,23 @@ class CommandBuilder:
                                0x00,
                                payload)
 
+    def get_eth2_public_addr_batch_first(self,
+                                         bip32_path: str,
+                                         level: int,
+                                         count: int) -> bytes:
+        payload = pack_derivation_path(bip32_path)
+        payload += struct.pack(">BB", level, count)
+        return self._serialize(InsType.GET_ETH2_PUBLIC_ADDR,
+                               P1Type.BATCH_FIRST,
+                               0x00,
+                               payload)
+
+    def get_eth2_public_addr_batch_next(self) -> bytes:
+        return self._serialize(InsType.GET_ETH2_PUBLIC_ADDR,
+                               P1Type.BATCH_NEXT,
+                               0x00,
+                               bytes())
+
     def perform_privacy_operation(self,
                                   display: bool,
                                   bip32_path: str,
@@ -16,6 +16,11 @@ app_client: EthAppClient = None
 filtering_paths: dict = {}
 current_path: list[str] = list()
 sig_ctx: dict[str, Any] = {}
+# field values waiting to be sent in a single APDU, None if not batching
+batched_values: Optional[list[bytes]] = None
+
+# max payload of a batched struct implementation APDU
+BATCH_MAX_SIZE = 0xff
 
 
 def default_handler():
@@ -99,7 +104,7 @@ parsing_type_functions["string"] = parse_string
 parsing_type_functions["bytes"] = parse_bytes
 
 
-def send_struct_def_field(typename, keyname):
+def parse_struct_def_field(typename):
     type_enum = None
 
     (typename, array_lvls) = get_array_levels(typename)
@@ -110,6 +115,11 @@ def send_struct_def_field(typename, keyname):
     else:
         type_enum = EIP712FieldType.CUSTOM
         typesize = None
+    return (typename, type_enum, typesize, array_lvls)
+
+
+def send_struct_def_field(typename, keyname):
+    (typename, type_enum, typesize, array_lvls) = parse_struct_def_field(typename)
 
     with app_client.eip712_send_struct_def_struct_field(type_enum,
                                                         typename,
@@ -201,26 +211,29 @@ def send_struct_impl_field(value, field):
     if filtering_paths:
         path = ".".join(current_path)
         if path in filtering_paths.keys():
-            if filtering_paths[path]["type"] == "amount_join_token":
-                send_filtering_amount_join_token(filtering_paths[path]["token"])
-            elif filtering_paths[path]["type"] == "amount_join_value":
-                if "token" in filtering_paths[path].keys():
-                    token = filtering_paths[path]["token"]
-                else:
-                    # Permit (ERC-2612)
-                    token = 0xff
-                send_filtering_amount_join_value(token,
-                                                 filtering_paths[path]["name"])
-            elif filtering_paths[path]["type"] == "datetime":
-                send_filtering_datetime(filtering_paths[path]["name"])
-            elif filtering_paths[path]["type"] == "raw":
-                send_filtering_raw(filtering_paths[path]["name"])
-            else:
-                assert False
-
-    with app_client.eip712_send_struct_impl_struct_field(data):
-        enable_autonext()
-    disable_autonext()
+            # the filter applies to the next field the app receives
+            flush_struct_impl_fields()
+            send_filter(path, filtering_paths[path])
+
+    if batched_values is not None and (2 + len(data)) <= BATCH_MAX_SIZE:
+        if (sum(2 + len(v) for v in batched_values) + 2 + len(data)) > BATCH_MAX_SIZE:
+            flush_struct_impl_fields()
+        batched_values.append(data)
+    else:
+        flush_struct_impl_fields()
+        with app_client.eip712_send_struct_impl_struct_field(data):
+            enable_autonext()
+        disable_autonext()
+
+
+def flush_struct_impl_fields():
+    global batched_values
+
+    if batched_values:
+        with app_client.eip712_send_struct_impl_struct_fields(batched_values):
+            enable_autonext()
+        disable_autonext()
+        batched_values = list()
 
 
 def evaluate_field(structs, data, field, lvls_left, new_level=True):
@@ -229,6 +242,7 @@ def evaluate_field(structs, data, field, lvls_left, new_level=True):
     if new_level:
         current_path.append(field["name"])
     if len(array_lvls) > 0 and lvls_left > 0:
+        flush_struct_impl_fields()
         with app_client.eip712_send_struct_impl_array(len(data)):
             pass
         idx = 0
@@ -278,81 +292,122 @@ def start_signature_payload(ctx: dict, magic: int) -> bytearray:
     return to_sign
 
 
-# ledgerjs doesn't actually sign anything, and instead uses already pre-computed signatures
-def send_filtering_message_info(display_name: str, filters_count: int):
-    global sig_ctx
-
-    to_sign = start_signature_payload(sig_ctx, 183)
-    to_sign.append(filters_count)
-    to_sign += display_name.encode()
-
-    sig = keychain.sign_data(keychain.Key.CAL, to_sign)
-    with app_client.eip712_filtering_message_info(display_name, filters_count, sig):
-        enable_autonext()
-    disable_autonext()
+def filter_token_idx(filtr: dict) -> int:
+    if "token" in filtr.keys():
+        return filtr["token"]
+    # Permit (ERC-2612)
+    return 0xff
+
+
+def filter_payload(path: str, filtr: dict) -> bytearray:
+    if filtr["type"] == "amount_join_token":
+        to_sign = start_signature_payload(sig_ctx, 11)
+        to_sign += path.encode()
+        to_sign.append(filtr["token"])
+    elif filtr["type"] == "amount_join_value":
+        to_sign = start_signature_payload(sig_ctx, 22)
+        to_sign += path.encode()
+        to_sign += filtr["name"].encode()
+        to_sign.append(filter_token_idx(filtr))
+    elif filtr["type"] == "datetime":
+        to_sign = start_signature_payload(sig_ctx, 33)
+        to_sign += path.encode()
+        to_sign += filtr["name"].encode()
+    elif filtr["type"] == "raw":
+        to_sign = start_signature_payload(sig_ctx, 72)
+        to_sign += path.encode()
+        to_sign += filtr["name"].encode()
+    else:
+        assert False
+    return to_sign
 
 
-def send_filtering_amount_join_token(token_idx: int):
-    global sig_ctx
+def manifest_node(a: bytes, b: bytes) -> bytes:
+    return hashlib.sha256(b"\x01" + min(a, b) + max(a, b)).digest()
 
-    path_str = ".".join(current_path)
 
-    to_sign = start_signature_payload(sig_ctx, 11)
-    to_sign += path_str.encode()
-    to_sign.append(token_idx)
-    sig = keychain.sign_data(keychain.Key.CAL, to_sign)
-    with app_client.eip712_filtering_amount_join_token(token_idx, sig):
-        pass
+# Hash tree of all the filters, from the leaves to the root.
+# The last node of a level with an odd count is promoted as-is to the next one.
+def build_manifest(leaves: list[bytes]) -> list[list[bytes]]:
+    levels = [sorted(set(leaves))]
+    while len(levels[-1]) > 1:
+        level = levels[-1]
+        parent = [manifest_node(level[i], level[i + 1]) for i in range(0, len(level) - 1, 2)]
+        if len(level) % 2 == 1:
+            parent.append(level[-1])
+        levels.append(parent)
+    return levels
 
 
-def send_filtering_amount_join_value(token_idx: int, display_name: str):
-    global sig_ctx
+def manifest_proof(to_sign: bytes) -> bytes:
+    node = hashlib.sha256(to_sign).digest()
+    proof = bytearray()
+    for level in sig_ctx["manifest"][:-1]:
+        idx = level.index(node)
+        sibling = idx ^ 1
+        if sibling < len(level):
+            proof += level[sibling]
+            node = manifest_node(node, level[sibling])
+    return proof
 
-    path_str = ".".join(current_path)
 
-    to_sign = start_signature_payload(sig_ctx, 22)
-    to_sign += path_str.encode()
-    to_sign += display_name.encode()
-    to_sign.append(token_idx)
-    sig = keychain.sign_data(keychain.Key.CAL, to_sign)
-    with app_client.eip712_filtering_amount_join_value(token_idx, display_name, sig):
-        pass
+# Either a signature of the filter, or a proof that it is part of the manifest
+def filter_auth(to_sign: bytes) -> bytes:
+    if "manifest" in sig_ctx:
+        return manifest_proof(to_sign)
+    return keychain.sign_data(keychain.Key.CAL, to_sign)
 
 
-def send_filtering_datetime(display_name: str):
+# ledgerjs doesn't actually sign anything, and instead uses already pre-computed signatures
+def send_filtering_message_info(display_name: str, filters_count: int):
     global sig_ctx
 
-    path_str = ".".join(current_path)
-
-    to_sign = start_signature_payload(sig_ctx, 33)
-    to_sign += path_str.encode()
+    root = None
+    if "manifest" in sig_ctx:
+        root = sig_ctx["manifest"][-1][0]
+        to_sign = start_signature_payload(sig_ctx, 184)
+    else:
+        to_sign = start_signature_payload(sig_ctx, 183)
+    to_sign.append(filters_count)
     to_sign += display_name.encode()
-    sig = keychain.sign_data(keychain.Key.CAL, to_sign)
-    with app_client.eip712_filtering_datetime(display_name, sig):
-        pass
-
+    if root is not None:
+        to_sign += root
 
-# ledgerjs doesn't actually sign anything, and instead uses already pre-computed signatures
-def send_filtering_raw(display_name):
-    global sig_ctx
+    sig = keychain.sign_data(keychain.Key.CAL, to_sign)
+    with app_client.eip712_filtering_message_info(display_name, filters_count, sig, root):
+        enable_autonext()
+    disable_autonext()
 
-    path_str = ".".join(current_path)
 
-    to_sign = start_signature_payload(sig_ctx, 72)
-    to_sign += path_str.encode()
-    to_sign += display_name.encode()
-    sig = keychain.sign_data(keychain.Key.CAL, to_sign)
-    with app_client.eip712_filtering_raw(display_name, sig):
-        pass
+def send_filter(path: str, filtr: dict):
+    auth = filter_auth(filter_payload(path, filtr))
+    if filtr["type"] == "amount_join_token":
+        with app_client.eip712_filtering_amount_join_token(filtr["token"], auth):
+            pass
+    elif filtr["type"] == "amount_join_value":
+        with app_client.eip712_filtering_amount_join_value(filter_token_idx(filtr),
+                                                           filtr["name"],
+                                                           auth):
+            pass
+    elif filtr["type"] == "datetime":
+        with app_client.eip712_filtering_datetime(filtr["name"], auth):
+            pass
+    elif filtr["type"] == "raw":
+        with app_client.eip712_filtering_raw(filtr["name"], auth):
+            pass
 
 
-def prepare_filtering(filtr_data, message):
+def prepare_filtering(filtr_data, message, manifest: bool):
     global filtering_paths
 
     if "fields" in filtr_data:
         filtering_paths = filtr_data["fields"]
     else:
         filtering_paths = {}
+    if manifest:
+        leaves = [hashlib.sha256(filter_payload(path, filtr)).digest()
+                  for (path, filtr) in filtering_paths.items()]
+        sig_ctx["manifest"] = build_manifest(leaves) if leaves else [[bytes(32)]]
     if "tokens" in filtr_data:
         for token in filtr_data["tokens"]:
             app_client.provide_token_metadata(token["ticker"],
@@ -371,6 +426,7 @@ def handle_optional_domain_values(domain):
 def init_signature_context(types, domain):
     global sig_ctx
 
+    sig_ctx = {}
     handle_optional_domain_values(domain)
     caddr = domain["verifyingContract"]
     if caddr.startswith("0x"):
@@ -412,11 +468,14 @@ def process_data(aclient: EthAppClient,
                  data_json: dict,
                  filters: Optional[dict] = None,
                  autonext: Optional[Callable] = None,
-                 golden_run: bool = False) -> bool:
+                 golden_run: bool = False,
+                 batch: bool = False,
+                 manifest: bool = False) -> bool:
     global sig_ctx
     global app_client
     global autonext_handler
     global is_golden_run
+    global batched_values
 
     # deepcopy because this function modifies the dict
     data_json = copy.deepcopy(data_json)
@@ -432,22 +491,38 @@ def process_data(aclient: EthAppClient,
         signal.signal(signal.SIGALRM, next_timeout)
 
     is_golden_run = golden_run
+    batched_values = list() if batch else None
 
     if filters:
         init_signature_context(types, domain)
 
     # send types definition
-    for key in types.keys():
-        with app_client.eip712_send_struct_def_struct_name(key):
+    if batch:
+        struct_defs = dict()
+        for key in types.keys():
+            struct_defs[key] = list()
+            for f in types[key]:
+                (f["type"], f["enum"], f["typesize"], f["array_lvls"]) = \
+                 parse_struct_def_field(f["type"])
+                struct_defs[key].append((f["enum"],
+                                         f["type"],
+                                         f["typesize"],
+                                         f["array_lvls"],
+                                         f["name"]))
+        with app_client.eip712_send_struct_defs(struct_defs):
             pass
-        for f in types[key]:
-            (f["type"], f["enum"], f["typesize"], f["array_lvls"]) = \
-             send_struct_def_field(f["type"], f["name"])
+    else:
+        for key in types.keys():
+            with app_client.eip712_send_struct_def_struct_name(key):
+                pass
+            for f in types[key]:
+                (f["type"], f["enum"], f["typesize"], f["array_lvls"]) = \
+                 send_struct_def_field(f["type"], f["name"])
 
     if filters:
         with app_client.eip712_filtering_activate():
             pass
-        prepare_filtering(filters, message)
+        prepare_filtering(filters, message, manifest)
 
     # send domain implementation
     with app_client.eip712_send_struct_impl_root_struct(domain_typename):
@@ -455,6 +530,7 @@ def process_data(aclient: EthAppClient,
     disable_autonext()
     if not send_struct_impl(types, domain, domain_typename):
         return False
+    flush_struct_impl_fields()
 
     if filters:
         if filters and "name" in filters:
@@ -468,5 +544,6 @@ def process_data(aclient: EthAppClient,
     disable_autonext()
     if not send_struct_impl(types, message, message_typename):
         return False
+    flush_struct_impl_fields()
 
     return True
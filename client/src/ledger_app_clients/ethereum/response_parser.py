@@ -50,3 +50,32 @@ def pk_addr(data: bytes, has_chaincode: bool = False):
         return None
 
     return pk, bytes.fromhex(addr.decode()), chaincode
+
+
+def pk_addr_batch(data: bytes) -> list[tuple[bytes, bytes]]:
+    entries = list()
+
+    if len(data) < 1:
+        return None
+    count = data[0]
+    idx = 1
+
+    if len(data) != (idx + count * (33 + 20)):
+        return None
+    for _ in range(count):
+        pk = data[idx:idx + 33]
+        idx += 33
+        addr = data[idx:idx + 20]
+        idx += 20
+        entries.append((pk, addr))
+    return entries
+
+
+def eth2_pk_batch(data: bytes) -> list[bytes]:
+    if len(data) < 1:
+        return None
+    count = data[0]
+
+    if len(data) != (1 + count * 48):
+        return None
+    return [data[1 + i * 48:1 + (i + 1) * 48] for i in range(count)]
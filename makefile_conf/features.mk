@@ -37,6 +37,14 @@ ifneq ($(TARGET_NAME),TARGET_NANOS)
     DEFINES += HAVE_DYN_MEM_ALLOC
 endif
 
+# Memory usage statistics of the dynamic allocator, readable with the GET MEM STATS APDU
+MEM_STATS ?= 0
+ifneq ($(MEM_STATS),0)
+    ifneq ($(TARGET_NAME),TARGET_NANOS)
+        DEFINES += HAVE_MEM_STATS
+    endif
+endif
+
 # EIP-712
 ifneq ($(TARGET_NAME),TARGET_NANOS)
     DEFINES	+= HAVE_EIP712_FULL_SUPPORT
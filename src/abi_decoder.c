@@ -0,0 +1,206 @@
+/**
+ * Streaming decoder of Solidity ABI encoded function parameters
+ *
+ * The calldata is received one 32-byte word at a time, in order. Given the schema of the
+ * top-level parameters, the decoder goes through the static heads, then follows the offsets
+ * of the dynamic parameters to their tails, in a single pass and with a fixed amount of RAM.
+ * Each word is reported as a typed event so that the plugins only have to handle the
+ * parameters they are interested in.
+ *
+ * Only the canonical layout is accepted: the tails have to directly follow the heads and
+ * each other, in any order, without gaps nor overlaps.
+ */
+
+#include <string.h>
+#include "abi_decoder.h"
+#include "os.h"
+
+/**
+ * Read a 32-byte big-endian integer that has to fit in 32 bits
+ *
+ * @param[in] word the ABI word
+ * @param[out] value the integer
+ * @return whether it fits
+ */
+static bool abi_read_u32(const uint8_t *word, uint32_t *value) {
+    for (uint8_t i = 0; i < (ABI_WORD_SIZE - sizeof(*value)); ++i) {
+        if (word[i] != 0) {
+            return false;
+        }
+    }
+    *value = ((uint32_t) word[28] << 24) | ((uint32_t) word[29] << 16) |
+             ((uint32_t) word[30] << 8) | word[31];
+    return true;
+}
+
+/**
+ * Initialize the decoder for a new set of parameters
+ *
+ * @param[out] decoder the decoder
+ * @param[in] schema the type of each top-level parameter
+ * @param[in] param_count number of top-level parameters
+ * @return whether the schema is supported
+ */
+bool abi_decoder_init(abi_decoder_t *decoder, const uint8_t *schema, uint8_t param_count) {
+    if (param_count > ABI_MAX_PARAMS) {
+        return false;
+    }
+    explicit_bzero(decoder, sizeof(*decoder));
+    decoder->schema = PIC(schema);
+    decoder->param_count = param_count;
+    decoder->current = ABI_NO_PARAM;
+    return true;
+}
+
+/**
+ * Handle a word of the heads section
+ *
+ * @param[in,out] decoder the decoder
+ * @param[in] word the ABI word
+ * @param[out] event the decoded event
+ * @return whether the word is valid
+ */
+static bool abi_feed_head(abi_decoder_t *decoder, const uint8_t *word, abi_event_t *event) {
+    uint8_t param = decoder->head_index++;
+    uint32_t offset;
+
+    event->param = param;
+    if (decoder->schema[param] == ABI_TYPE_WORD) {
+        event->type = ABI_EVENT_WORD;
+        return true;
+    }
+    if (!abi_read_u32(word, &offset) || ((offset % ABI_WORD_SIZE) != 0) ||
+        (offset < (decoder->param_count * ABI_WORD_SIZE))) {
+        PRINTF("Invalid offset for ABI parameter %u\n", param);
+        return false;
+    }
+    decoder->offsets[param] = offset;
+    event->type = ABI_EVENT_OFFSET;
+    event->value = offset;
+    return true;
+}
+
+/**
+ * Handle the length word of a dynamic parameter, starting to read its tail
+ *
+ * @param[in,out] decoder the decoder
+ * @param[in] word the ABI word
+ * @param[out] event the decoded event
+ * @return whether the word is valid
+ */
+static bool abi_feed_length(abi_decoder_t *decoder, const uint8_t *word, abi_event_t *event) {
+    uint8_t param;
+    uint32_t length;
+    uint32_t words;
+
+    for (param = 0; param < decoder->param_count; ++param) {
+        if ((decoder->schema[param] != ABI_TYPE_WORD) && !(decoder->done_mask & (1 << param)) &&
+            (decoder->offsets[param] == decoder->position)) {
+            break;
+        }
+    }
+    if (param == decoder->param_count) {
+        if (abi_decoder_done(decoder)) {
+            event->type = ABI_EVENT_TRAILING;
+            return true;
+        }
+        PRINTF("Non-canonical ABI encoding at offset %u\n", decoder->position);
+        return false;
+    }
+    if (!abi_read_u32(word, &length)) {
+        return false;
+    }
+    if (decoder->schema[param] == ABI_TYPE_BYTES) {
+        words = (length / ABI_WORD_SIZE) + (((length % ABI_WORD_SIZE) != 0) ? 1 : 0);
+    } else {
+        words = length;
+    }
+    if (words > ABI_MAX_DYN_WORDS) {
+        PRINTF("ABI parameter %u is too long\n", param);
+        return false;
+    }
+    decoder->bytes_left = length;
+    decoder->words_left = words;
+    decoder->index = 0;
+    if (words > 0) {
+        decoder->current = param;
+    } else {
+        decoder->done_mask |= (1 << param);
+    }
+    event->type = ABI_EVENT_LENGTH;
+    event->param = param;
+    event->value = length;
+    return true;
+}
+
+/**
+ * Handle a word of the tail of the current dynamic parameter
+ *
+ * @param[in,out] decoder the decoder
+ * @param[out] event the decoded event
+ */
+static void abi_feed_tail(abi_decoder_t *decoder, abi_event_t *event) {
+    event->param = decoder->current;
+    event->index = decoder->index++;
+    if (decoder->schema[decoder->current] == ABI_TYPE_BYTES) {
+        event->type = ABI_EVENT_BYTES_CHUNK;
+        event->value = (decoder->bytes_left < ABI_WORD_SIZE) ? decoder->bytes_left : ABI_WORD_SIZE;
+        decoder->bytes_left -= event->value;
+    } else {
+        event->type = ABI_EVENT_ELEMENT;
+    }
+    if (--decoder->words_left == 0) {
+        decoder->done_mask |= (1 << decoder->current);
+        decoder->current = ABI_NO_PARAM;
+    }
+}
+
+/**
+ * Feed the next word of the parameters to the decoder
+ *
+ * @param[in,out] decoder the decoder
+ * @param[in] offset offset of the word, relative to the start of the parameters
+ * @param[in] word the ABI word
+ * @param[out] event the decoded event, pointing to the given word
+ * @return whether the word is valid
+ */
+bool abi_decoder_feed(abi_decoder_t *decoder,
+                      uint32_t offset,
+                      const uint8_t *word,
+                      abi_event_t *event) {
+    bool ret = true;
+
+    if (offset != decoder->position) {
+        PRINTF("Unexpected ABI word offset %u (expected %u)\n", offset, decoder->position);
+        return false;
+    }
+    explicit_bzero(event, sizeof(*event));
+    event->word = word;
+    if (decoder->head_index < decoder->param_count) {
+        ret = abi_feed_head(decoder, word, event);
+    } else if (decoder->current == ABI_NO_PARAM) {
+        ret = abi_feed_length(decoder, word, event);
+    } else {
+        abi_feed_tail(decoder, event);
+    }
+    decoder->position += ABI_WORD_SIZE;
+    return ret;
+}
+
+/**
+ * Check whether all the parameters have been fully decoded
+ *
+ * @param[in] decoder the decoder
+ * @return whether they have
+ */
+bool abi_decoder_done(const abi_decoder_t *decoder) {
+    if ((decoder->head_index < decoder->param_count) || (decoder->current != ABI_NO_PARAM)) {
+        return false;
+    }
+    for (uint8_t param = 0; param < decoder->param_count; ++param) {
+        if ((decoder->schema[param] != ABI_TYPE_WORD) && !(decoder->done_mask & (1 << param))) {
+            return false;
+        }
+    }
+    return true;
+}
@@ -0,0 +1,65 @@
+#ifndef ABI_DECODER_H_
+#define ABI_DECODER_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#define ABI_WORD_SIZE 32
+
+// maximum number of top-level parameters in a schema
+#define ABI_MAX_PARAMS 6
+
+// maximum number of words in a dynamic value
+#define ABI_MAX_DYN_WORDS 0xffff
+
+#define ABI_NO_PARAM 0xff
+
+typedef enum {
+    ABI_TYPE_WORD = 0,  // any static value (address, uintN, bool, bytesN)
+    ABI_TYPE_BYTES,     // bytes or string
+    ABI_TYPE_ARRAY,     // dynamic array of static values (T[])
+} abi_type_t;
+
+typedef enum {
+    ABI_EVENT_WORD = 0,     // static parameter
+    ABI_EVENT_OFFSET,       // offset of a dynamic parameter, from its head
+    ABI_EVENT_LENGTH,       // length of a dynamic parameter, from its tail
+    ABI_EVENT_ELEMENT,      // array element
+    ABI_EVENT_BYTES_CHUNK,  // chunk of a bytes value
+    ABI_EVENT_TRAILING,     // word past the end of the encoded parameters
+} abi_event_type_t;
+
+typedef struct {
+    abi_event_type_t type;
+    uint8_t param;
+    // element or chunk index
+    uint16_t index;
+    // offset, length, or number of meaningful bytes in a chunk
+    uint32_t value;
+    const uint8_t *word;
+} abi_event_t;
+
+typedef struct {
+    const uint8_t *schema;
+    uint32_t offsets[ABI_MAX_PARAMS];
+    // offset of the next expected word, relative to the start of the parameters
+    uint32_t position;
+    // bytes still expected in the current bytes value
+    uint32_t bytes_left;
+    uint16_t words_left;
+    uint16_t index;
+    uint8_t param_count;
+    uint8_t head_index;
+    uint8_t current;
+    // bitmask of the dynamic parameters whose tail has been read
+    uint8_t done_mask;
+} abi_decoder_t;
+
+bool abi_decoder_init(abi_decoder_t *decoder, const uint8_t *schema, uint8_t param_count);
+bool abi_decoder_feed(abi_decoder_t *decoder,
+                      uint32_t offset,
+                      const uint8_t *word,
+                      abi_event_t *event);
+bool abi_decoder_done(const abi_decoder_t *decoder);
+
+#endif  // ABI_DECODER_H_
@@ -24,8 +24,11 @@
 #define INS_EIP712_FILTERING                0x1E
 #define INS_ENS_GET_CHALLENGE               0x20
 #define INS_ENS_PROVIDE_INFO                0x22
+#define INS_GET_MEM_STATS                   0x24
 #define P1_CONFIRM                          0x01
 #define P1_NON_CONFIRM                      0x00
+#define P1_BATCH_FIRST                      0x02
+#define P1_BATCH_NEXT                       0x03
 #define P2_NO_CHAINCODE                     0x00
 #define P2_CHAINCODE                        0x01
 #define P1_FIRST                            0x00
@@ -129,6 +132,17 @@ void handleSetEth2WinthdrawalIndex(uint8_t p1,
 
 #endif
 
+#ifdef HAVE_MEM_STATS
+
+void handleGetMemStats(uint8_t p1,
+                       uint8_t p2,
+                       const uint8_t *workBuffer,
+                       uint8_t dataLength,
+                       unsigned int *flags,
+                       unsigned int *tx);
+
+#endif
+
 extern uint16_t apdu_response_code;
 
 #endif  // _APDU_CONSTANTS_H_
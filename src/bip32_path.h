@@ -0,0 +1,13 @@
+#ifndef _BIP32_PATH_H_
+#define _BIP32_PATH_H_
+
+#include <stdint.h>
+
+#define MAX_BIP32_PATH 10
+
+typedef struct bip32_path_t {
+    uint8_t length;
+    uint32_t path[MAX_BIP32_PATH];
+} bip32_path_t;
+
+#endif  // _BIP32_PATH_H_
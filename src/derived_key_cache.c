@@ -0,0 +1,82 @@
+/**
+ * Cache of the public keys derived during the app session
+ *
+ * Showing the "From" address, checking an address for a swap and getting a public key all
+ * derive the same few paths from the seed over and over, which is costly. Only public data is
+ * kept here (public key, chain code & addresses), signing still derives the private key.
+ */
+
+#ifndef TARGET_NANOS
+
+#include <string.h>
+#include "derived_key_cache.h"
+#include "common_utils.h"
+#include "crypto_helpers.h"
+
+static derived_key_t derived_keys[DERIVED_KEY_CACHE_SIZE];
+static uint8_t derived_keys_count;
+static uint8_t derived_keys_next;
+
+/**
+ * Find a path in the cache
+ *
+ * @param[in] path BIP32 path
+ * @param[in] path_length BIP32 path length
+ * @return the cached key if found, \ref NULL otherwise
+ */
+static derived_key_t *find_derived_key(const uint32_t *path, uint8_t path_length) {
+    for (uint8_t i = 0; i < derived_keys_count; ++i) {
+        if ((derived_keys[i].path.length == path_length) &&
+            (memcmp(derived_keys[i].path.path, path, path_length * sizeof(*path)) == 0)) {
+            return &derived_keys[i];
+        }
+    }
+    return NULL;
+}
+
+/**
+ * Get the public key, chain code & address of a BIP32 path
+ *
+ * Derives it from the seed only if it has not been already during this session.
+ *
+ * @param[in] path BIP32 path
+ * @param[in] path_length BIP32 path length
+ * @param[in] chain_id chain ID used for the address checksum
+ * @return the derived key, \ref NULL if the derivation failed
+ */
+const derived_key_t *get_derived_key(const uint32_t *path, uint8_t path_length, uint64_t chain_id) {
+    derived_key_t *key;
+
+    if ((path_length == 0) || (path_length > MAX_BIP32_PATH)) {
+        return NULL;
+    }
+    if ((key = find_derived_key(path, path_length)) == NULL) {
+        key = &derived_keys[derived_keys_next];
+        // invalidate it while it is being overwritten
+        key->path.length = 0;
+        if (bip32_derive_get_pubkey_256(CX_CURVE_256K1,
+                                        path,
+                                        path_length,
+                                        key->raw_pubkey,
+                                        key->chain_code,
+                                        CX_SHA512) != CX_OK) {
+            return NULL;
+        }
+        getEthAddressFromRawKey(key->raw_pubkey, key->address);
+        getEthAddressStringFromRawKey(key->raw_pubkey, key->address_str, chain_id);
+        key->chain_id = chain_id;
+        memcpy(key->path.path, path, path_length * sizeof(*path));
+        key->path.length = path_length;
+        derived_keys_next = (derived_keys_next + 1) % DERIVED_KEY_CACHE_SIZE;
+        if (derived_keys_count < DERIVED_KEY_CACHE_SIZE) {
+            derived_keys_count += 1;
+        }
+    } else if (key->chain_id != chain_id) {
+        // only the checksum of the address string depends on it
+        getEthAddressStringFromRawKey(key->raw_pubkey, key->address_str, chain_id);
+        key->chain_id = chain_id;
+    }
+    return key;
+}
+
+#endif  // TARGET_NANOS
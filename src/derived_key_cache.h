@@ -0,0 +1,26 @@
+#ifndef DERIVED_KEY_CACHE_H_
+#define DERIVED_KEY_CACHE_H_
+
+// No RAM to spare for it on Nano S, where the callers derive the keys directly
+#ifndef TARGET_NANOS
+
+#include <stdint.h>
+#include "common_utils.h"
+#include "bip32_path.h"
+
+#define DERIVED_KEY_CACHE_SIZE 4
+
+typedef struct {
+    bip32_path_t path;
+    uint64_t chain_id;  // the one the address checksum has been computed for
+    uint8_t raw_pubkey[65];
+    uint8_t chain_code[32];
+    uint8_t address[ADDRESS_LENGTH];
+    char address_str[ADDRESS_LENGTH * 2 + 1];
+} derived_key_t;
+
+const derived_key_t *get_derived_key(const uint32_t *path, uint8_t path_length, uint64_t chain_id);
+
+#endif  // TARGET_NANOS
+
+#endif  // DERIVED_KEY_CACHE_H_
@@ -135,7 +135,9 @@ static void processChainID(txContext_t *context) {
     if (context->currentFieldPos < context->currentFieldLength) {
         uint32_t copySize =
             MIN(context->commandLength, context->currentFieldLength - context->currentFieldPos);
-        copyTxData(context, context->content->chainID.value, copySize);
+        copyTxData(context,
+                   context->content->chainID.value + context->currentFieldPos,
+                   copySize);
     }
     if (context->currentFieldPos == context->currentFieldLength) {
         context->content->chainID.length = context->currentFieldLength;
@@ -156,7 +158,9 @@ static void processNonce(txContext_t *context) {
     if (context->currentFieldPos < context->currentFieldLength) {
         uint32_t copySize =
             MIN(context->commandLength, context->currentFieldLength - context->currentFieldPos);
-        copyTxData(context, context->content->nonce.value, copySize);
+        copyTxData(context,
+                   context->content->nonce.value + context->currentFieldPos,
+                   copySize);
     }
     if (context->currentFieldPos == context->currentFieldLength) {
         context->content->nonce.length = context->currentFieldLength;
@@ -460,9 +464,59 @@ static bool processLegacyTx(txContext_t *context) {
     return false;
 }
 
+// Decode the RLP header in place when it is entirely contained in the current APDU,
+// and hash it with a single call instead of one call per byte
+static parserStatus_e parseRLPFast(txContext_t *context) {
+    bool valid;
+    uint32_t offset;
+
+    if (!rlpCanDecode(context->workBuffer, context->commandLength, &valid)) {
+        // Header split across APDUs, let the slow path buffer it
+        return USTREAM_PROCESSING;
+    }
+    if (!valid) {
+        PRINTF("RLP pre-decode error\n");
+        return USTREAM_FAULT;
+    }
+    if (!rlpDecodeLength(context->workBuffer,
+                         &context->currentFieldLength,
+                         &offset,
+                         &context->currentFieldIsList)) {
+        PRINTF("RLP decode error\n");
+        return USTREAM_FAULT;
+    }
+    if (offset == 0) {
+        // Single byte, self encoded : hash it now and leave it in the buffer for the field
+        // processor, which will not hash it again
+        CX_ASSERT(
+            cx_hash_no_throw((cx_hash_t *) context->sha3, 0, context->workBuffer, 1, NULL, 0));
+        context->fieldSingleByte = true;
+    } else {
+        CX_ASSERT(cx_hash_no_throw((cx_hash_t *) context->sha3,
+                                   0,
+                                   context->workBuffer,
+                                   offset,
+                                   NULL,
+                                   0));
+        context->workBuffer += offset;
+        context->commandLength -= offset;
+        context->fieldSingleByte = false;
+    }
+    context->currentFieldPos = 0;
+    context->processingField = true;
+    return USTREAM_CONTINUE;
+}
+
 static parserStatus_e parseRLP(txContext_t *context) {
     bool canDecode = false;
     uint32_t offset;
+
+    if (context->rlpBufferPos == 0) {
+        parserStatus_e status = parseRLPFast(context);
+        if (status != USTREAM_PROCESSING) {
+            return status;
+        }
+    }
     while (context->commandLength != 0) {
         bool valid;
         // Feed the RLP buffer until the length can be decoded
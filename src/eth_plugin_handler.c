@@ -21,6 +21,16 @@ void eth_plugin_prepare_provide_parameter(ethPluginProvideParameter_t *providePa
     provideParameter->parameterOffset = parameterOffset;
 }
 
+void eth_plugin_prepare_provide_parameters(ethPluginProvideParameters_t *provideParameters,
+                                           const uint8_t *parameters,
+                                           uint32_t parameterOffset,
+                                           uint8_t parametersCount) {
+    memset((uint8_t *) provideParameters, 0, sizeof(ethPluginProvideParameters_t));
+    provideParameters->parameters = parameters;
+    provideParameters->parameterOffset = parameterOffset;
+    provideParameters->parametersCount = parametersCount;
+}
+
 void eth_plugin_prepare_finalize(ethPluginFinalize_t *finalize) {
     memset((uint8_t *) finalize, 0, sizeof(ethPluginFinalize_t));
 }
@@ -101,42 +111,57 @@ static void eth_plugin_perform_init_default(uint8_t *contractAddress,
 
 static bool eth_plugin_perform_init_old_internal(uint8_t *contractAddress,
                                                  ethPluginInitContract_t *init) {
-    uint8_t i, j;
-    const uint8_t *const *selectors;
+    const plugin_selector_t *match;
 
+    if (contractAddress == NULL) {
+        return false;
+    }
     // Search internal plugin list
-    for (i = 0;; i++) {
-        selectors = (const uint8_t *const *) PIC(INTERNAL_ETH_PLUGINS[i].selectors);
-        if (selectors == NULL) {
-            break;
-        }
-        for (j = 0; ((j < INTERNAL_ETH_PLUGINS[i].num_selectors) && (contractAddress != NULL));
-             j++) {
-            if (memcmp(init->selector, (const void *) PIC(selectors[j]), SELECTOR_SIZE) == 0) {
-                if ((INTERNAL_ETH_PLUGINS[i].availableCheck == NULL) ||
-                    ((PluginAvailableCheck) PIC(INTERNAL_ETH_PLUGINS[i].availableCheck))()) {
-                    strlcpy(dataContext.tokenContext.pluginName,
-                            INTERNAL_ETH_PLUGINS[i].alias,
-                            PLUGIN_ID_LENGTH);
-                    dataContext.tokenContext.pluginStatus = ETH_PLUGIN_RESULT_OK;
-                    return true;
-                }
-            }
+    for (uint8_t i = 0; INTERNAL_ETH_PLUGINS[i].alias[0] != 0; i++) {
+        match = plugin_selector_find(init->selector, INTERNAL_ETH_PLUGINS[i].id);
+        if ((match != NULL) &&
+            ((INTERNAL_ETH_PLUGINS[i].availableCheck == NULL) ||
+             ((PluginAvailableCheck) PIC(INTERNAL_ETH_PLUGINS[i].availableCheck))())) {
+            strlcpy(dataContext.tokenContext.pluginName,
+                    INTERNAL_ETH_PLUGINS[i].alias,
+                    PLUGIN_ID_LENGTH);
+            dataContext.tokenContext.selectorIndex = match->index;
+            dataContext.tokenContext.pluginStatus = ETH_PLUGIN_RESULT_OK;
+            return true;
         }
     }
 
     return false;
 }
 
+#ifdef HAVE_NFT_SUPPORT
+static void eth_plugin_perform_init_nft(ethPluginInitContract_t *init) {
+    const plugin_selector_t *match;
+
+    match = plugin_selector_find(init->selector,
+                                 (pluginType == ERC721) ? INTERNAL_PLUGIN_ERC721
+                                                        : INTERNAL_PLUGIN_ERC1155);
+    if (match != NULL) {
+        dataContext.tokenContext.selectorIndex = match->index;
+    }
+}
+#endif  // HAVE_NFT_SUPPORT
+
 eth_plugin_result_t eth_plugin_perform_init(uint8_t *contractAddress,
                                             ethPluginInitContract_t *init) {
     dataContext.tokenContext.pluginStatus = ETH_PLUGIN_RESULT_UNAVAILABLE;
+    dataContext.tokenContext.selectorIndex = PLUGIN_SELECTOR_UNKNOWN;
+    dataContext.tokenContext.pluginBatchSupported = false;
 
     PRINTF("Selector %.*H\n", 4, init->selector);
     switch (pluginType) {
 #ifdef HAVE_NFT_SUPPORT
         case ERC1155:
         case ERC721:
+            eth_plugin_perform_init_default(contractAddress, init);
+            eth_plugin_perform_init_nft(init);
+            contractAddress = NULL;
+            break;
 #endif  // HAVE_NFT_SUPPORT
         case EXTERNAL:
             eth_plugin_perform_init_default(contractAddress, init);
@@ -174,6 +199,9 @@ eth_plugin_result_t eth_plugin_perform_init(uint8_t *contractAddress,
         return status;
     }
     PRINTF("eth_plugin_init ok %s\n", dataContext.tokenContext.pluginName);
+    // only worth it for external plugins, each call being a library call
+    dataContext.tokenContext.pluginBatchSupported =
+        (pluginType == EXTERNAL) && (init->interfaceVersion >= ETH_PLUGIN_INTERFACE_VERSION_BATCH);
     dataContext.tokenContext.pluginStatus = ETH_PLUGIN_RESULT_OK;
     return ETH_PLUGIN_RESULT_OK;
 }
@@ -199,7 +227,7 @@ eth_plugin_result_t eth_plugin_call(int method, void *parameter) {
         case ETH_PLUGIN_INIT_CONTRACT:
             PRINTF("-- PLUGIN INIT CONTRACT --\n");
             ((ethPluginInitContract_t *) parameter)->interfaceVersion =
-                ETH_PLUGIN_INTERFACE_VERSION_LATEST;
+                ETH_PLUGIN_INTERFACE_VERSION_ANNOUNCED;
             ((ethPluginInitContract_t *) parameter)->result = ETH_PLUGIN_RESULT_UNAVAILABLE;
             ((ethPluginInitContract_t *) parameter)->pluginSharedRW = &pluginRW;
             ((ethPluginInitContract_t *) parameter)->pluginSharedRO = &pluginRO;
@@ -216,6 +244,14 @@ eth_plugin_result_t eth_plugin_call(int method, void *parameter) {
             ((ethPluginProvideParameter_t *) parameter)->pluginContext =
                 (uint8_t *) &dataContext.tokenContext.pluginContext;
             break;
+        case ETH_PLUGIN_PROVIDE_PARAMETERS:
+            PRINTF("-- PLUGIN PROVIDE PARAMETERS --\n");
+            ((ethPluginProvideParameters_t *) parameter)->result = ETH_PLUGIN_RESULT_UNAVAILABLE;
+            ((ethPluginProvideParameters_t *) parameter)->pluginSharedRW = &pluginRW;
+            ((ethPluginProvideParameters_t *) parameter)->pluginSharedRO = &pluginRO;
+            ((ethPluginProvideParameters_t *) parameter)->pluginContext =
+                (uint8_t *) &dataContext.tokenContext.pluginContext;
+            break;
         case ETH_PLUGIN_FINALIZE:
             PRINTF("-- PLUGIN FINALIZE --\n");
             ((ethPluginFinalize_t *) parameter)->result = ETH_PLUGIN_RESULT_UNAVAILABLE;
@@ -324,6 +360,17 @@ eth_plugin_result_t eth_plugin_call(int method, void *parameter) {
                     return ETH_PLUGIN_RESULT_UNAVAILABLE;
             }
             break;
+        case ETH_PLUGIN_PROVIDE_PARAMETERS:
+            switch (((ethPluginProvideParameters_t *) parameter)->result) {
+                case ETH_PLUGIN_RESULT_OK:
+                case ETH_PLUGIN_RESULT_FALLBACK:
+                    break;
+                case ETH_PLUGIN_RESULT_ERROR:
+                    return ETH_PLUGIN_RESULT_ERROR;
+                default:
+                    return ETH_PLUGIN_RESULT_UNAVAILABLE;
+            }
+            break;
         case ETH_PLUGIN_FINALIZE:
             switch (((ethPluginFinalize_t *) parameter)->result) {
                 case ETH_PLUGIN_RESULT_OK:
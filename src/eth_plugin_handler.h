@@ -8,12 +8,42 @@
 
 #define NO_NFT_METADATA (NO_EXTRA_INFO(tmpCtx, 0))
 
+// Plugin interface additions, only defined here until the plugin SDK provides them
+#ifndef ETH_PLUGIN_PROVIDE_PARAMETERS
+// First interface version with ETH_PLUGIN_PROVIDE_PARAMETERS. The plugins implementing it report
+// it back in the interfaceVersion field of ETH_PLUGIN_INIT_CONTRACT.
+#define ETH_PLUGIN_INTERFACE_VERSION_BATCH (ETH_PLUGIN_INTERFACE_VERSION_LATEST + 1)
+
+// Batched variant of ETH_PLUGIN_PROVIDE_PARAMETER, giving all the complete parameters
+// currently available in one call
+#define ETH_PLUGIN_PROVIDE_PARAMETERS 0x0107
+
+typedef struct ethPluginProvideParameters_t {
+    ethPluginSharedRW_t *pluginSharedRW;
+    ethPluginSharedRO_t *pluginSharedRO;
+    uint8_t *pluginContext;
+    const uint8_t *parameters;  // parametersCount consecutive 32 bytes parameters
+    uint32_t parameterOffset;   // offset of the first parameter, the next ones follow
+    uint8_t parametersCount;
+
+    uint8_t result;
+} ethPluginProvideParameters_t;
+#endif  // ETH_PLUGIN_PROVIDE_PARAMETERS
+
+// Version announced in ETH_PLUGIN_INIT_CONTRACT, the last one without batching so that the
+// plugins built against an older SDK keep accepting it
+#define ETH_PLUGIN_INTERFACE_VERSION_ANNOUNCED (ETH_PLUGIN_INTERFACE_VERSION_BATCH - 1)
+
 void eth_plugin_prepare_init(ethPluginInitContract_t *init,
                              const uint8_t *selector,
                              uint32_t dataSize);
 void eth_plugin_prepare_provide_parameter(ethPluginProvideParameter_t *provideParameter,
                                           uint8_t *parameter,
                                           uint32_t parameterOffset);
+void eth_plugin_prepare_provide_parameters(ethPluginProvideParameters_t *provideParameters,
+                                           const uint8_t *parameters,
+                                           uint32_t parameterOffset,
+                                           uint8_t parametersCount);
 void eth_plugin_prepare_finalize(ethPluginFinalize_t *finalize);
 void eth_plugin_prepare_provide_info(ethPluginProvideInfo_t *provideToken);
 void eth_plugin_prepare_query_contract_ID(ethQueryContractID_t *queryContractID,
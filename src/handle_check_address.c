@@ -4,6 +4,7 @@
 #include "shared_context.h"
 #include "string.h"
 #include "crypto_helpers.h"
+#include "derived_key_cache.h"
 
 #define ZERO(x) explicit_bzero(&x, sizeof(x))
 
@@ -20,8 +21,12 @@ void handle_check_address(check_address_parameters_t* params, const chain_config
     const uint8_t* bip32_path_ptr = params->address_parameters;
     uint8_t bip32PathLength = *(bip32_path_ptr++);
     uint32_t bip32Path[MAX_BIP32_PATH];
+#ifdef TARGET_NANOS
     char address[51];
     uint8_t raw_pubkey[65];
+#else
+    const derived_key_t* key;
+#endif
 
     if ((bip32PathLength < 0x01) || (bip32PathLength > MAX_BIP32_PATH) ||
         (bip32PathLength * 4 != params->address_parameters_length - 1)) {
@@ -33,6 +38,7 @@ void handle_check_address(check_address_parameters_t* params, const chain_config
         bip32_path_ptr += 4;
     }
 
+#ifdef TARGET_NANOS
     if (bip32_derive_get_pubkey_256(CX_CURVE_256K1,
                                     bip32Path,
                                     bip32PathLength,
@@ -43,6 +49,12 @@ void handle_check_address(check_address_parameters_t* params, const chain_config
     }
 
     getEthAddressStringFromRawKey((const uint8_t*) raw_pubkey, address, chain_config->chainId);
+#else
+    if ((key = get_derived_key(bip32Path, bip32PathLength, chain_config->chainId)) == NULL) {
+        THROW(APDU_RESPONSE_UNKNOWN);
+    }
+    const char* address = key->address_str;
+#endif
 
     uint8_t offset_0x = 0;
     if (memcmp(params->address_to_check, "0x", 2) == 0) {
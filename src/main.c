@@ -316,6 +316,17 @@ void handleApdu(unsigned int *flags, unsigned int *tx) {
                     break;
 #endif  // HAVE_DOMAIN_NAME
 
+#ifdef HAVE_MEM_STATS
+                case INS_GET_MEM_STATS:
+                    handleGetMemStats(G_io_apdu_buffer[OFFSET_P1],
+                                      G_io_apdu_buffer[OFFSET_P2],
+                                      G_io_apdu_buffer + OFFSET_CDATA,
+                                      G_io_apdu_buffer[OFFSET_LC],
+                                      flags,
+                                      tx);
+                    break;
+#endif  // HAVE_MEM_STATS
+
 #if 0
         case 0xFF: // return to dashboard
           goto return_to_dashboard;
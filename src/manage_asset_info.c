@@ -2,49 +2,197 @@
 #include "shared_context.h"
 
 void forget_known_assets(void) {
-    memset(tmpCtx.transactionContext.assetSet, false, MAX_ASSETS);
+    memset(tmpCtx.transactionContext.assetEntries,
+           0,
+           sizeof(tmpCtx.transactionContext.assetEntries));
     tmpCtx.transactionContext.currentAssetIndex = 0;
 }
 
 static extraInfo_t *get_asset_info(int index) {
-    if ((index < 0) || (index >= MAX_ASSETS)) {
+    if ((index < 0) || (index >= (int) MAX_ASSETS)) {
         return NULL;
     }
     return &tmpCtx.transactionContext.extraInfo[index];
 }
 
-static bool asset_info_is_set(int index) {
-    if ((index < 0) || (index >= MAX_ASSETS)) {
+bool asset_info_is_set(int index) {
+    if ((index < 0) || (index >= (int) MAX_ASSETS)) {
         return false;
     }
-    return tmpCtx.transactionContext.assetSet[index];
+    return tmpCtx.transactionContext.assetEntries[index].flags & ASSET_ENTRY_SET;
 }
 
-int get_asset_index_by_addr(const uint8_t *addr) {
+static uint64_t get_asset_chain_id(int index) {
+    const assetCacheEntry_t *entry = &tmpCtx.transactionContext.assetEntries[index];
+
+    return tmpCtx.transactionContext.assetChainIds[entry->flags & ASSET_ENTRY_CHAIN_MASK];
+}
+
+/**
+ * Make an asset the most recently used one
+ *
+ * @param[in] index asset index, set or about to be
+ */
+static void touch_asset_info(int index) {
+    assetCacheEntry_t *entries = tmpCtx.transactionContext.assetEntries;
+    uint8_t rank = asset_info_is_set(index) ? entries[index].rank : MAX_ASSETS;
+
+    for (int i = 0; i < (int) MAX_ASSETS; i++) {
+        if ((i != index) && asset_info_is_set(i) && (entries[i].rank < rank)) {
+            entries[i].rank += 1;
+        }
+    }
+    entries[index].rank = 0;
+}
+
+/**
+ * Remove an asset from the cache, keeping the ranks of the others contiguous
+ *
+ * @param[in] index asset index
+ */
+static void drop_asset_info(int index) {
+    assetCacheEntry_t *entries = tmpCtx.transactionContext.assetEntries;
+
+    entries[index].flags &= ~ASSET_ENTRY_SET;
+    for (int i = 0; i < (int) MAX_ASSETS; i++) {
+        if (asset_info_is_set(i) && (entries[i].rank > entries[index].rank)) {
+            entries[i].rank -= 1;
+        }
+    }
+}
+
+int get_asset_index_by_addr(const uint8_t *addr, uint64_t chain_id) {
     // Works for ERC-20 & NFT tokens since both structs in the union have the
     // contract address aligned
-    for (int i = 0; i < MAX_ASSETS; i++) {
+    for (int i = 0; i < (int) MAX_ASSETS; i++) {
         extraInfo_t *asset = get_asset_info(i);
-        if (asset_info_is_set(i) && (memcmp(asset->token.address, addr, ADDRESS_LENGTH) == 0)) {
+        if (asset_info_is_set(i) && ((chain_id == 0) || (get_asset_chain_id(i) == chain_id)) &&
+            (memcmp(asset->token.address, addr, ADDRESS_LENGTH) == 0)) {
             PRINTF("Token found at index %d\n", i);
+            touch_asset_info(i);
             return i;
         }
     }
     return -1;
 }
 
-extraInfo_t *get_asset_info_by_addr(const uint8_t *addr) {
-    return get_asset_info(get_asset_index_by_addr(addr));
+extraInfo_t *get_asset_info_by_addr(const uint8_t *addr, uint64_t chain_id) {
+    return get_asset_info(get_asset_index_by_addr(addr, chain_id));
 }
 
-extraInfo_t *get_current_asset_info(void) {
-    return get_asset_info(tmpCtx.transactionContext.currentAssetIndex);
+uint8_t get_known_assets_count(void) {
+    uint8_t count = 0;
+
+    for (int i = 0; i < (int) MAX_ASSETS; i++) {
+        if (asset_info_is_set(i)) {
+            count += 1;
+        }
+    }
+    return count;
 }
 
-void validate_current_asset_info(void) {
+/**
+ * Find the slot the next provided asset will be stored in
+ *
+ * @return the first free slot if any, the least recently used one otherwise
+ */
+static uint8_t get_next_asset_index(void) {
+    const assetCacheEntry_t *entries = tmpCtx.transactionContext.assetEntries;
+    uint8_t lru_index = 0;
+
+    for (uint8_t i = 0; i < MAX_ASSETS; i++) {
+        if (!asset_info_is_set(i)) {
+            return i;
+        }
+        if (entries[i].rank > entries[lru_index].rank) {
+            lru_index = i;
+        }
+    }
+    PRINTF("Evicting asset at index %d\n", lru_index);
+    return lru_index;
+}
+
+/**
+ * Reserve the slot the asset being provided gets written to
+ *
+ * The asset it held, if any, is evicted right away: it is overwritten while the new one is being
+ * parsed, so it stays evicted even if the new one gets rejected.
+ *
+ * @return the reserved slot
+ */
+extraInfo_t *reserve_asset_slot(void) {
+    uint8_t index = get_next_asset_index();
+
+    // about to be overwritten
+    if (asset_info_is_set(index)) {
+        drop_asset_info(index);
+    }
+    tmpCtx.transactionContext.currentAssetIndex = index;
+    return get_asset_info(index);
+}
+
+/**
+ * Get the index of a chain ID in the chain IDs of the cached assets, adding it if needed
+ *
+ * If they are all in use, the assets of the chain that has been used the least recently are
+ * evicted.
+ *
+ * @param[in] chain_id chain ID
+ * @return its index
+ */
+static uint8_t get_asset_chain_index(uint64_t chain_id) {
+    uint64_t *chain_ids = tmpCtx.transactionContext.assetChainIds;
+    const assetCacheEntry_t *entries = tmpCtx.transactionContext.assetEntries;
+    // most recent rank of the assets of each chain, MAX_ASSETS if it has none
+    uint8_t chain_ranks[ASSETS_CHAINS_COUNT];
+    uint8_t chain_idx;
+    uint8_t lru_chain_idx = 0;
+
+    for (chain_idx = 0; chain_idx < ASSETS_CHAINS_COUNT; ++chain_idx) {
+        chain_ranks[chain_idx] = MAX_ASSETS;
+    }
+    for (int i = 0; i < (int) MAX_ASSETS; i++) {
+        chain_idx = entries[i].flags & ASSET_ENTRY_CHAIN_MASK;
+        if (asset_info_is_set(i) && (entries[i].rank < chain_ranks[chain_idx])) {
+            chain_ranks[chain_idx] = entries[i].rank;
+        }
+    }
+    for (chain_idx = 0; chain_idx < ASSETS_CHAINS_COUNT; ++chain_idx) {
+        if ((chain_ranks[chain_idx] < MAX_ASSETS) && (chain_ids[chain_idx] == chain_id)) {
+            return chain_idx;
+        }
+        if (chain_ranks[chain_idx] > chain_ranks[lru_chain_idx]) {
+            lru_chain_idx = chain_idx;
+        }
+    }
+    if (chain_ranks[lru_chain_idx] < MAX_ASSETS) {
+        PRINTF("Evicting the assets of chain ID %u\n", (uint32_t) chain_ids[lru_chain_idx]);
+        for (int i = 0; i < (int) MAX_ASSETS; i++) {
+            if (asset_info_is_set(i) &&
+                ((entries[i].flags & ASSET_ENTRY_CHAIN_MASK) == lru_chain_idx)) {
+                drop_asset_info(i);
+            }
+        }
+    }
+    chain_ids[lru_chain_idx] = chain_id;
+    return lru_chain_idx;
+}
+
+void validate_current_asset_info(uint64_t chain_id) {
+    uint8_t index = tmpCtx.transactionContext.currentAssetIndex;
+    const extraInfo_t *asset = get_asset_info(index);
+    uint8_t chain_idx = get_asset_chain_index(chain_id);
+
+    // drop an older copy of the same asset so that lookups stay unambiguous
+    for (int i = 0; i < (int) MAX_ASSETS; i++) {
+        if (asset_info_is_set(i) && (get_asset_chain_id(i) == chain_id) &&
+            (memcmp(get_asset_info(i)->token.address, asset->token.address, ADDRESS_LENGTH) ==
+             0)) {
+            drop_asset_info(i);
+        }
+    }
+    touch_asset_info(index);
     // mark it as set
-    tmpCtx.transactionContext.assetSet[tmpCtx.transactionContext.currentAssetIndex] = true;
-    // increment index
-    tmpCtx.transactionContext.currentAssetIndex =
-        (tmpCtx.transactionContext.currentAssetIndex + 1) % MAX_ASSETS;
+    tmpCtx.transactionContext.assetEntries[index].flags = ASSET_ENTRY_SET | chain_idx;
+    PRINTF("Asset cache: %d/%d slots used\n", get_known_assets_count(), (int) MAX_ASSETS);
 }
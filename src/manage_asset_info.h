@@ -6,9 +6,11 @@
 #include "asset_info.h"
 
 void forget_known_assets(void);
-int get_asset_index_by_addr(const uint8_t *addr);
-extraInfo_t *get_asset_info_by_addr(const uint8_t *contractAddress);
-extraInfo_t *get_current_asset_info(void);
-void validate_current_asset_info(void);
+bool asset_info_is_set(int index);
+int get_asset_index_by_addr(const uint8_t *addr, uint64_t chain_id);
+extraInfo_t *get_asset_info_by_addr(const uint8_t *contractAddress, uint64_t chain_id);
+extraInfo_t *reserve_asset_slot(void);
+uint8_t get_known_assets_count(void);
+void validate_current_asset_info(uint64_t chain_id);
 
 #endif  // MANAGE_ASSET_INFO_H_
@@ -4,23 +4,30 @@
  * The two functions alloc & dealloc use the buffer as a simple stack.
  * Especially useful when an unpredictable amount of data will be received and have to be stored
  * during the transaction but discarded right after.
+ *
+ * A mark of the current position can also be taken, to later release everything that has been
+ * allocated since at once.
  */
 
 #ifdef HAVE_DYN_MEM_ALLOC
 
 #include <stdint.h>
+#include <string.h>
 #include "mem.h"
 
 #define SIZE_MEM_BUFFER 8192
 
 static uint8_t mem_buffer[SIZE_MEM_BUFFER];
 static size_t mem_idx;
+static e_mem_tag mem_tag;
+static s_mem_stats mem_stats = {.size = SIZE_MEM_BUFFER};
 
 /**
  * Initializes the memory buffer index
  */
 void mem_init(void) {
     mem_idx = 0;
+    mem_tag = MEM_TAG_OTHER;
 }
 
 /**
@@ -45,6 +52,11 @@ void *mem_alloc(size_t size) {
         return NULL;
     }
     mem_idx += size;
+    mem_stats.allocated[mem_tag] += size;
+    if (mem_idx > mem_stats.peak) {
+        mem_stats.peak = mem_idx;
+        mem_stats.peak_tag = mem_tag;
+    }
     return &mem_buffer[mem_idx - size];
 }
 
@@ -62,4 +74,77 @@ void mem_dealloc(size_t size) {
     }
 }
 
+/**
+ * Allocate and align, required when dealing with pointers of multi-bytes data
+ * like structures that will be dereferenced at runtime.
+ *
+ * @param[in] size the size of the data we want to allocate in memory
+ * @param[in] alignment the byte alignment needed
+ * @return pointer to the memory area, \ref NULL if the allocation failed
+ */
+void *mem_alloc_and_align(size_t size, size_t alignment) {
+    size_t align_diff = (uintptr_t) &mem_buffer[mem_idx] % alignment;
+    size_t padding = (align_diff > 0) ? (alignment - align_diff) : 0;
+    uint8_t *ptr;
+
+    if ((ptr = mem_alloc(padding + size)) == NULL) {
+        return NULL;
+    }
+    return ptr + padding;
+}
+
+/**
+ * Get the current position in the memory buffer
+ *
+ * @return the mark, to be given to \ref mem_release_to
+ */
+size_t mem_mark(void) {
+    return mem_idx;
+}
+
+/**
+ * De-allocates everything that has been allocated since a mark was taken
+ *
+ * @param[in] mark the mark returned by \ref mem_mark
+ */
+void mem_release_to(size_t mark) {
+    if (mark < mem_idx) {
+        mem_idx = mark;
+    }
+}
+
+/**
+ * Set the tag with which the next allocations are accounted
+ *
+ * @param[in] tag the new tag
+ * @return the previous tag, to restore it afterwards
+ */
+e_mem_tag mem_set_tag(e_mem_tag tag) {
+    e_mem_tag previous = mem_tag;
+
+    if (tag < MEM_TAG_COUNT) {
+        mem_tag = tag;
+    }
+    return previous;
+}
+
+/**
+ * Get the memory usage statistics
+ *
+ * @return pointer to the statistics
+ */
+const s_mem_stats *mem_get_stats(void) {
+    mem_stats.used = mem_idx;
+    return &mem_stats;
+}
+
+/**
+ * Reset the peak usage & the per-tag accounting
+ */
+void mem_reset_stats(void) {
+    memset(mem_stats.allocated, 0, sizeof(mem_stats.allocated));
+    mem_stats.peak = mem_idx;
+    mem_stats.peak_tag = mem_tag;
+}
+
 #endif  // HAVE_DYN_MEM_ALLOC
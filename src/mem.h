@@ -4,11 +4,41 @@
 #ifdef HAVE_DYN_MEM_ALLOC
 
 #include <stdlib.h>
+#include <stdint.h>
+
+#define MEM_ALLOC_AND_ALIGN_TYPE(type) mem_alloc_and_align(sizeof(type), __alignof__(type))
+
+// what the memory is allocated for, only used for the usage statistics
+typedef enum {
+    MEM_TAG_OTHER = 0,
+    MEM_TAG_EIP712_TYPED_DATA,
+    MEM_TAG_EIP712_PATH,
+    MEM_TAG_EIP712_UI,
+    MEM_TAG_TLV_PAYLOAD,
+    MEM_TAG_EIP712_FILTERING,
+    MEM_TAG_COUNT
+} e_mem_tag;
+
+typedef struct {
+    uint16_t size;
+    uint16_t used;
+    uint16_t peak;
+    // tag that was set when the peak was reached
+    uint8_t peak_tag;
+    // bytes allocated with each tag since the statistics were reset
+    uint32_t allocated[MEM_TAG_COUNT];
+} s_mem_stats;
 
 void mem_init(void);
 void mem_reset(void);
 void *mem_alloc(size_t size);
 void mem_dealloc(size_t size);
+void *mem_alloc_and_align(size_t size, size_t alignment);
+size_t mem_mark(void);
+void mem_release_to(size_t mark);
+e_mem_tag mem_set_tag(e_mem_tag tag);
+const s_mem_stats *mem_get_stats(void);
+void mem_reset_stats(void);
 
 #endif  // HAVE_DYN_MEM_ALLOC
 
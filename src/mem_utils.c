@@ -36,25 +36,4 @@ char *mem_alloc_and_format_uint(uint32_t value, uint8_t *const length) {
     return mem_ptr;
 }
 
-/**
- * Allocate and align, required when dealing with pointers of multi-bytes data
- * like structures that will be dereferenced at runtime.
- *
- * @param[in] size the size of the data we want to allocate in memory
- * @param[in] alignment the byte alignment needed
- *
- * @return pointer to the memory area, \ref NULL if the allocation failed
- */
-void *mem_alloc_and_align(size_t size, size_t alignment) {
-    uint8_t align_diff = (uintptr_t) mem_alloc(0) % alignment;
-
-    if (align_diff > 0)  // alignment needed
-    {
-        if (mem_alloc(alignment - align_diff) == NULL) {
-            return NULL;
-        }
-    }
-    return mem_alloc(size);
-}
-
 #endif  // HAVE_DYN_MEM_ALLOC
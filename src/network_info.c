@@ -0,0 +1,53 @@
+#include <stddef.h>
+#include "os_pic.h"
+#include "network.h"
+#include "net_table.gen.h"
+
+/**
+ * Get the index of a network in the generated tables
+ *
+ * Binary search over \ref g_network_chain_ids which is sorted at generation.
+ *
+ * @param[in] chain_id network's chain ID
+ * @return the index if found, -1 otherwise
+ */
+static int get_network_index(const uint64_t *chain_id) {
+    size_t low = 0;
+    size_t high = NETWORK_COUNT;
+
+    while (low < high) {
+        size_t mid = low + ((high - low) / 2);
+
+        if (g_network_chain_ids[mid] == *chain_id) {
+            return mid;
+        }
+        if (g_network_chain_ids[mid] < *chain_id) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+    return -1;
+}
+
+const char *get_network_name_from_chain_id(const uint64_t *chain_id) {
+    int idx = get_network_index(chain_id);
+
+    if (idx == -1) {
+        return NULL;
+    }
+    return PIC(&g_network_strings[g_network_names[idx]]);
+}
+
+const char *get_network_ticker_from_chain_id(const uint64_t *chain_id) {
+    int idx = get_network_index(chain_id);
+
+    if (idx == -1) {
+        return NULL;
+    }
+    return PIC(&g_network_strings[g_network_tickers[idx]]);
+}
+
+bool chain_is_ethereum_compatible(const uint64_t *chain_id) {
+    return get_network_index(chain_id) != -1;
+}
@@ -0,0 +1,44 @@
+/**
+ * Batching of the parameters given to a plugin
+ *
+ * When the plugin handles ETH_PLUGIN_PROVIDE_PARAMETERS, all the complete parameters of the
+ * received chunk of calldata are given to it at once. Otherwise, or when a parameter straddles
+ * two chunks, they are given one by one with ETH_PLUGIN_PROVIDE_PARAMETER.
+ */
+
+#include "plugin_batch.h"
+
+#define MIN(a, b) (((a) < (b)) ? (a) : (b))
+
+/**
+ * Get the number of parameters that can be given in a single batch
+ *
+ * @param[in] supported whether the plugin handles batches
+ * @param[in] field_offset number of bytes of the next parameter already received
+ * @param[in] available number of calldata bytes left in the received chunk
+ * @param[in] field_left number of calldata bytes left in the whole data field
+ * @return the number of parameters, 0 if they have to be given one by one
+ */
+uint8_t plugin_batch_count(bool supported,
+                           uint32_t field_offset,
+                           uint32_t available,
+                           uint32_t field_left) {
+    uint32_t count;
+
+    if (!supported || (field_offset != 0)) {
+        return 0;
+    }
+    count = MIN(MIN(available, field_left) / PLUGIN_PARAMETER_SIZE, UINT8_MAX);
+    // a single parameter is just as cheap to give on its own
+    return (count < 2) ? 0 : count;
+}
+
+/**
+ * Get the offset of a parameter from the beginning of the data field
+ *
+ * @param[in] field_index index of the parameter
+ * @return its offset
+ */
+uint32_t plugin_parameter_offset(uint32_t field_index) {
+    return (field_index * PLUGIN_PARAMETER_SIZE) + PLUGIN_PARAMETERS_OFFSET;
+}
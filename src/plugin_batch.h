@@ -0,0 +1,18 @@
+#ifndef PLUGIN_BATCH_H_
+#define PLUGIN_BATCH_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#define PLUGIN_PARAMETER_SIZE 32
+
+// offset of the first parameter in the data field, following the selector
+#define PLUGIN_PARAMETERS_OFFSET 4
+
+uint8_t plugin_batch_count(bool supported,
+                           uint32_t field_offset,
+                           uint32_t available,
+                           uint32_t field_left);
+uint32_t plugin_parameter_offset(uint32_t field_index);
+
+#endif  // PLUGIN_BATCH_H_
@@ -0,0 +1,96 @@
+/**
+ * Selectors handled by the internal plugins
+ *
+ * A single table, sorted by selector, maps each of them to its plugin & the index of the
+ * method within that plugin. A selector can be shared by several plugins (ERC-20 & ERC-721
+ * approve for example), the entries are then contiguous.
+ */
+
+#include "plugin_selectors.h"
+#include "os.h"
+
+#define ARRAY_LEN(a) (sizeof(a) / sizeof((a)[0]))
+
+const plugin_selector_t g_plugin_selectors[] = {
+    {0x095ea7b3, INTERNAL_PLUGIN_ERC20, ERC20_APPROVE},
+#ifdef HAVE_NFT_SUPPORT
+    {0x095ea7b3, INTERNAL_PLUGIN_ERC721, ERC721_APPROVE},
+#endif
+#ifdef HAVE_ETH2
+    {0x22895118, INTERNAL_PLUGIN_ETH2, ETH2_DEPOSIT},
+#endif
+#ifdef HAVE_NFT_SUPPORT
+    {0x23b872dd, INTERNAL_PLUGIN_ERC721, ERC721_TRANSFER},
+    {0x2eb2c2d6, INTERNAL_PLUGIN_ERC1155, ERC1155_SAFE_BATCH_TRANSFER},
+    {0x42842e0e, INTERNAL_PLUGIN_ERC721, ERC721_SAFE_TRANSFER},
+    {0xa22cb465, INTERNAL_PLUGIN_ERC721, ERC721_SET_APPROVAL_FOR_ALL},
+    {0xa22cb465, INTERNAL_PLUGIN_ERC1155, ERC1155_SET_APPROVAL_FOR_ALL},
+#endif
+    {0xa9059cbb, INTERNAL_PLUGIN_ERC20, ERC20_TRANSFER},
+#ifdef HAVE_NFT_SUPPORT
+    {0xb88d4fde, INTERNAL_PLUGIN_ERC721, ERC721_SAFE_TRANSFER_DATA},
+    {0xf242432a, INTERNAL_PLUGIN_ERC1155, ERC1155_SAFE_TRANSFER},
+#endif
+};
+
+const size_t g_plugin_selectors_count = ARRAY_LEN(g_plugin_selectors);
+
+#ifdef HAVE_MEM_STATS
+// number of times each selector has been matched during the app session
+static uint16_t g_plugin_selector_hits[ARRAY_LEN(g_plugin_selectors)];
+#endif
+
+/**
+ * Find the entry of a selector for a given internal plugin
+ *
+ * @param[in] selector 4-byte selector
+ * @param[in] plugin internal plugin ID
+ * @return pointer to the entry, or NULL if the plugin does not handle this selector
+ */
+const plugin_selector_t *plugin_selector_find(const uint8_t *selector, uint8_t plugin) {
+    const plugin_selector_t *table = PIC(g_plugin_selectors);
+    uint32_t value = ((uint32_t) selector[0] << 24) | ((uint32_t) selector[1] << 16) |
+                     ((uint32_t) selector[2] << 8) | selector[3];
+    size_t low = 0;
+    size_t high = ARRAY_LEN(g_plugin_selectors);
+    size_t mid;
+
+    // lower bound, to land on the first entry of a shared selector
+    while (low < high) {
+        mid = low + (high - low) / 2;
+        if (table[mid].selector < value) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+    for (; (low < ARRAY_LEN(g_plugin_selectors)) && (table[low].selector == value); ++low) {
+        if (table[low].plugin == plugin) {
+#ifdef HAVE_MEM_STATS
+            if (g_plugin_selector_hits[low] < UINT16_MAX) {
+                g_plugin_selector_hits[low] += 1;
+            }
+#endif
+            return &table[low];
+        }
+    }
+    return NULL;
+}
+
+#ifdef HAVE_MEM_STATS
+/**
+ * Get the number of times each selector has been matched
+ *
+ * @return array with the same indices as g_plugin_selectors
+ */
+const uint16_t *get_plugin_selector_hits(void) {
+    return g_plugin_selector_hits;
+}
+
+/**
+ * Reset the number of times each selector has been matched
+ */
+void reset_plugin_selector_hits(void) {
+    explicit_bzero(g_plugin_selector_hits, sizeof(g_plugin_selector_hits));
+}
+#endif  // HAVE_MEM_STATS
@@ -0,0 +1,50 @@
+#ifndef PLUGIN_SELECTORS_H_
+#define PLUGIN_SELECTORS_H_
+
+#include <stdint.h>
+#include <stddef.h>
+
+#define PLUGIN_SELECTOR_UNKNOWN 0xff
+
+typedef enum {
+    INTERNAL_PLUGIN_ERC20 = 0,
+    INTERNAL_PLUGIN_ETH2,
+    INTERNAL_PLUGIN_ERC721,
+    INTERNAL_PLUGIN_ERC1155,
+} internal_plugin_id_t;
+
+typedef enum { ERC20_TRANSFER = 0, ERC20_APPROVE } erc20Selector_t;
+
+typedef enum { ETH2_DEPOSIT = 0 } eth2Selector_t;
+
+typedef enum {
+    ERC721_APPROVE = 0,
+    ERC721_SET_APPROVAL_FOR_ALL,
+    ERC721_TRANSFER,
+    ERC721_SAFE_TRANSFER,
+    ERC721_SAFE_TRANSFER_DATA,
+} erc721_selector_t;
+
+typedef enum {
+    ERC1155_SET_APPROVAL_FOR_ALL = 0,
+    ERC1155_SAFE_TRANSFER,
+    ERC1155_SAFE_BATCH_TRANSFER,
+} erc1155_selector_t;
+
+typedef struct {
+    uint32_t selector;
+    uint8_t plugin;
+    uint8_t index;
+} plugin_selector_t;
+
+// sorted by selector
+extern const plugin_selector_t g_plugin_selectors[];
+extern const size_t g_plugin_selectors_count;
+
+const plugin_selector_t *plugin_selector_find(const uint8_t *selector, uint8_t plugin);
+#ifdef HAVE_MEM_STATS
+const uint16_t *get_plugin_selector_hits(void);
+void reset_plugin_selector_hits(void);
+#endif
+
+#endif  // PLUGIN_SELECTORS_H_
@@ -10,24 +10,42 @@
 #include "tx_content.h"
 #include "chainConfig.h"
 #include "asset_info.h"
+#include "bip32_path.h"
 #ifdef HAVE_NBGL
 #include "nbgl_types.h"
 #endif
 
-#define MAX_BIP32_PATH 10
-
 #define SELECTOR_LENGTH 4
 
 #define PLUGIN_ID_LENGTH 30
 
 #define N_storage (*(volatile internalStorage_t *) PIC(&N_storage_real))
 
+typedef struct assetCacheEntry_t {
+    // position in the least recently used order among the set entries, 0 being the most recent
+    uint8_t rank;
+    // ASSET_ENTRY_SET | index of the chain ID in assetChainIds
+    uint8_t flags;
+} assetCacheEntry_t;
+
+#define ASSET_ENTRY_SET        (1 << 7)
+#define ASSET_ENTRY_CHAIN_MASK (0x7f)
+
+// number of distinct chain IDs the cached assets can have been provided for
+#define ASSETS_CHAINS_COUNT 2
+
+#ifdef TARGET_NANOS
+// as many slots as before the cache, no RAM to spare on this device
 #define MAX_ASSETS 5
+#else
+// RAM budget of the asset-info cache, in bytes
+#define ASSETS_CACHE_BUDGET 1024
+#define ASSETS_ENTRY_SIZE   (sizeof(extraInfo_t) + sizeof(assetCacheEntry_t))
+#define MAX_ASSETS          (ASSETS_CACHE_BUDGET / ASSETS_ENTRY_SIZE)
+#endif
 
-typedef struct bip32_path_t {
-    uint8_t length;
-    uint32_t path[MAX_BIP32_PATH];
-} bip32_path_t;
+_Static_assert(MAX_ASSETS >= 2, "Asset cache budget too small");
+_Static_assert(MAX_ASSETS < 0xff, "Asset index must fit in a byte");
 
 typedef struct internalStorage_t {
     bool contractDetails;
@@ -65,6 +83,10 @@ typedef struct tokenContext_t {
     };
 
     uint8_t pluginStatus;
+    // method of the internal plugin, PLUGIN_SELECTOR_UNKNOWN otherwise
+    uint8_t selectorIndex;
+    // the plugin declared an interface version handling ETH_PLUGIN_PROVIDE_PARAMETERS
+    bool pluginBatchSupported;
 
 } tokenContext_t;
 
@@ -78,10 +100,12 @@ typedef struct publicKeyContext_t {
 } publicKeyContext_t;
 
 typedef struct transactionContext_t {
+    // first so that it needs no padding
+    uint64_t assetChainIds[ASSETS_CHAINS_COUNT];
     bip32_path_t bip32;
     uint8_t hash[INT256_LENGTH];
     union extraInfo_t extraInfo[MAX_ASSETS];
-    bool assetSet[MAX_ASSETS];
+    assetCacheEntry_t assetEntries[MAX_ASSETS];
     uint8_t currentAssetIndex;
 } transactionContext_t;
 
@@ -0,0 +1,115 @@
+/**
+ * Cache of the payloads whose signature has already been verified
+ *
+ * Wallets send the same descriptors (tokens, NFTs, plugins...) over and over, this allows
+ * skipping the ECDSA verification of a payload already verified with the same key during
+ * the app session. It is not cleared by reset_app_context.
+ */
+
+#include <string.h>
+#include "sig_cache.h"
+#include "os.h"
+#include "cx.h"
+
+// truncated SHA-256 of the payload hash & public key
+#define SIG_CACHE_DIGEST_SIZE 16
+
+static uint8_t sig_cache[SIG_CACHE_SIZE][SIG_CACHE_DIGEST_SIZE];
+static uint8_t sig_cache_count;
+static uint8_t sig_cache_next;
+#ifdef HAVE_MEM_STATS
+static sig_cache_stats_t sig_cache_stats;
+#endif
+
+/**
+ * Compute the cache digest of a payload hash & the key it is verified with
+ *
+ * @param[in] raw_key public key
+ * @param[in] raw_key_len public key length
+ * @param[in] hash payload hash
+ * @param[in] hash_len payload hash length
+ * @param[out] digest cache digest
+ */
+static void sig_cache_digest(const uint8_t *raw_key,
+                             size_t raw_key_len,
+                             const uint8_t *hash,
+                             size_t hash_len,
+                             uint8_t digest[SIG_CACHE_DIGEST_SIZE]) {
+    cx_sha256_t hash_ctx;
+    uint8_t full_digest[CX_SHA256_SIZE];
+
+    cx_sha256_init(&hash_ctx);
+    CX_ASSERT(cx_hash_no_throw((cx_hash_t *) &hash_ctx, 0, hash, hash_len, NULL, 0));
+    CX_ASSERT(cx_hash_no_throw((cx_hash_t *) &hash_ctx,
+                               CX_LAST,
+                               raw_key,
+                               raw_key_len,
+                               full_digest,
+                               sizeof(full_digest)));
+    memcpy(digest, full_digest, SIG_CACHE_DIGEST_SIZE);
+}
+
+/**
+ * Verify the secp256k1 signature of a payload, unless it has already been verified
+ *
+ * @param[in] raw_key public key
+ * @param[in] raw_key_len public key length
+ * @param[in] hash payload hash
+ * @param[in] hash_len payload hash length
+ * @param[in] sig DER signature
+ * @param[in] sig_len signature length
+ * @return whether the signature is valid
+ */
+bool sig_cache_verify(const uint8_t *raw_key,
+                      size_t raw_key_len,
+                      const uint8_t *hash,
+                      size_t hash_len,
+                      const uint8_t *sig,
+                      size_t sig_len) {
+    uint8_t digest[SIG_CACHE_DIGEST_SIZE];
+    cx_ecfp_public_key_t verif_key;
+
+    sig_cache_digest(raw_key, raw_key_len, hash, hash_len, digest);
+    for (uint8_t i = 0; i < sig_cache_count; ++i) {
+        if (memcmp(sig_cache[i], digest, sizeof(digest)) == 0) {
+            PRINTF("Signature cache hit\n");
+#ifdef HAVE_MEM_STATS
+            sig_cache_stats.hits += 1;
+#endif
+            return true;
+        }
+    }
+#ifdef HAVE_MEM_STATS
+    sig_cache_stats.misses += 1;
+#endif
+
+    if ((cx_ecfp_init_public_key_no_throw(CX_CURVE_256K1, raw_key, raw_key_len, &verif_key) !=
+         CX_OK) ||
+        !cx_ecdsa_verify_no_throw(&verif_key, hash, hash_len, sig, sig_len)) {
+        return false;
+    }
+    memcpy(sig_cache[sig_cache_next], digest, sizeof(digest));
+    sig_cache_next = (sig_cache_next + 1) % SIG_CACHE_SIZE;
+    if (sig_cache_count < SIG_CACHE_SIZE) {
+        sig_cache_count += 1;
+    }
+    return true;
+}
+
+#ifdef HAVE_MEM_STATS
+/**
+ * Get the cache hit & miss counters
+ *
+ * @return the counters
+ */
+const sig_cache_stats_t *sig_cache_get_stats(void) {
+    return &sig_cache_stats;
+}
+
+/**
+ * Reset the cache hit & miss counters
+ */
+void sig_cache_reset_stats(void) {
+    explicit_bzero(&sig_cache_stats, sizeof(sig_cache_stats));
+}
+#endif  // HAVE_MEM_STATS
@@ -0,0 +1,29 @@
+#ifndef SIG_CACHE_H_
+#define SIG_CACHE_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+// number of verified payloads remembered for the app session
+#define SIG_CACHE_SIZE 8
+
+#ifdef HAVE_MEM_STATS
+typedef struct {
+    uint32_t hits;
+    uint32_t misses;
+} sig_cache_stats_t;
+#endif
+
+bool sig_cache_verify(const uint8_t *raw_key,
+                      size_t raw_key_len,
+                      const uint8_t *hash,
+                      size_t hash_len,
+                      const uint8_t *sig,
+                      size_t sig_len);
+#ifdef HAVE_MEM_STATS
+const sig_cache_stats_t *sig_cache_get_stats(void);
+void sig_cache_reset_stats(void);
+#endif
+
+#endif  // SIG_CACHE_H_
@@ -182,62 +182,53 @@ void mul128(const uint128_t *const number1,
     add128(&tmp, &tmp2, target);
 }
 
+static void u128_to_words(const uint128_t *const number, uint32_t words[UINT128_WORDS]) {
+    words[0] = (uint32_t) LOWER_P(number);
+    words[1] = (uint32_t) (LOWER_P(number) >> 32);
+    words[2] = (uint32_t) UPPER_P(number);
+    words[3] = (uint32_t) (UPPER_P(number) >> 32);
+}
+
+static void words_to_u128(const uint32_t words[UINT128_WORDS], uint128_t *const target) {
+    LOWER_P(target) = ((uint64_t) words[1] << 32) | words[0];
+    UPPER_P(target) = ((uint64_t) words[3] << 32) | words[2];
+}
+
 void divmod128(const uint128_t *const l,
                const uint128_t *const r,
                uint128_t *const retDiv,
                uint128_t *const retMod) {
-    uint128_t copyd, adder, resDiv, resMod;
-    uint128_t one;
-    UPPER(one) = 0;
-    LOWER(one) = 1;
-    uint32_t diffBits = bits128(l) - bits128(r);
-    clear128(&resDiv);
-    copy128(&resMod, l);
-    if (gt128(r, l)) {
-        copy128(retMod, l);
-        clear128(retDiv);
-    } else {
-        shiftl128(r, diffBits, &copyd);
-        shiftl128(&one, diffBits, &adder);
-        if (gt128(&copyd, &resMod)) {
-            shiftr128(&copyd, 1, &copyd);
-            shiftr128(&adder, 1, &adder);
-        }
-        while (gte128(&resMod, r)) {
-            if (gte128(&resMod, &copyd)) {
-                sub128(&resMod, &copyd, &resMod);
-                or128(&resDiv, &adder, &resDiv);
-            }
-            shiftr128(&copyd, 1, &copyd);
-            shiftr128(&adder, 1, &adder);
-        }
-        copy128(retDiv, &resDiv);
-        copy128(retMod, &resMod);
-    }
+    uint32_t num[UINT128_WORDS];
+    uint32_t den[UINT128_WORDS];
+    uint32_t quot[UINT128_WORDS];
+    uint32_t rem[UINT128_WORDS];
+
+    u128_to_words(l, num);
+    u128_to_words(r, den);
+    divmod_words(num, den, UINT128_WORDS, quot, rem);
+    words_to_u128(quot, retDiv);
+    words_to_u128(rem, retMod);
 }
 
 bool tostring128(const uint128_t *const number,
                  uint32_t baseParam,
                  char *const out,
                  uint32_t outLength) {
-    uint128_t rDiv;
-    uint128_t rMod;
-    uint128_t base;
-    copy128(&rDiv, number);
-    clear128(&rMod);
-    clear128(&base);
-    LOWER(base) = baseParam;
+    uint32_t words[UINT128_WORDS];
+    uint32_t count;
     uint32_t offset = 0;
     if ((baseParam < 2) || (baseParam > 16)) {
         return false;
     }
+    u128_to_words(number, words);
+    count = significant_words(words, UINT128_WORDS);
     do {
         if (offset > (outLength - 1)) {
             return false;
         }
-        divmod128(&rDiv, &base, &rDiv, &rMod);
-        out[offset++] = HEXDIGITS[(uint8_t) LOWER(rMod)];
-    } while (!zero128(&rDiv));
+        out[offset++] = HEXDIGITS[divmod_words_small(words, count, baseParam)];
+        count = significant_words(words, count);
+    } while (count > 0);
 
     if (offset > (outLength - 1)) {
         return false;
@@ -262,22 +253,16 @@ bool tostring128_signed(const uint128_t *const number,
                         char *const out,
                         uint32_t out_length) {
     uint128_t max_unsigned_val;
-    uint128_t max_signed_val;
     uint128_t one_val;
-    uint128_t two_val;
     uint128_t tmp;
 
     // showing negative numbers only really makes sense in base 10
     if (base == 10) {
-        explicit_bzero(&one_val, sizeof(one_val));
-        LOWER(one_val) = 1;
-        explicit_bzero(&two_val, sizeof(two_val));
-        LOWER(two_val) = 2;
-
-        memset(&max_unsigned_val, 0xFF, sizeof(max_unsigned_val));
-        divmod128(&max_unsigned_val, &two_val, &max_signed_val, &tmp);
-        if (gt128(number, &max_signed_val))  // negative value
+        if (UPPER_P(number) & 0x8000000000000000)  // negative value
         {
+            explicit_bzero(&one_val, sizeof(one_val));
+            LOWER(one_val) = 1;
+            memset(&max_unsigned_val, 0xFF, sizeof(max_unsigned_val));
             sub128(&max_unsigned_val, number, &tmp);
             add128(&tmp, &one_val, &tmp);
             out[0] = '-';
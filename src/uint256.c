@@ -23,6 +23,10 @@
 #include "uint_common.h"
 #include "common_utils.h"  // INT256_LENGTH
 
+// Largest power of 10 that fits in a single 32-bit word
+#define DECIMAL_CHUNK_DIVISOR 1000000000
+#define DECIMAL_CHUNK_DIGITS  9
+
 void readu256BE(const uint8_t *const buffer, uint256_t *const target) {
     readu128BE(buffer, &UPPER_P(target));
     readu128BE(buffer + 16, &LOWER_P(target));
@@ -177,61 +181,156 @@ void mul256(const uint256_t *const number1,
     }
 }
 
+static void u256_to_words(const uint256_t *const number, uint32_t words[UINT256_WORDS]) {
+    for (uint8_t i = 0; i < (UINT256_WORDS / 2); ++i) {
+        uint64_t chunk = number->elements[1 - (i / 2)].elements[1 - (i % 2)];
+        words[i * 2] = (uint32_t) chunk;
+        words[i * 2 + 1] = (uint32_t) (chunk >> 32);
+    }
+}
+
+static void words_to_u256(const uint32_t words[UINT256_WORDS], uint256_t *const target) {
+    for (uint8_t i = 0; i < (UINT256_WORDS / 2); ++i) {
+        target->elements[1 - (i / 2)].elements[1 - (i % 2)] =
+            ((uint64_t) words[i * 2 + 1] << 32) | words[i * 2];
+    }
+}
+
 void divmod256(const uint256_t *const l,
                const uint256_t *const r,
                uint256_t *const retDiv,
                uint256_t *const retMod) {
-    uint256_t copyd, adder, resDiv, resMod;
-    uint256_t one;
-    clear256(&one);
-    UPPER(LOWER(one)) = 0;
-    LOWER(LOWER(one)) = 1;
-    uint32_t diffBits = bits256(l) - bits256(r);
-    clear256(&resDiv);
-    copy256(&resMod, l);
-    if (gt256(r, l)) {
-        copy256(retMod, l);
-        clear256(retDiv);
-    } else {
-        shiftl256(r, diffBits, &copyd);
-        shiftl256(&one, diffBits, &adder);
-        if (gt256(&copyd, &resMod)) {
-            shiftr256(&copyd, 1, &copyd);
-            shiftr256(&adder, 1, &adder);
-        }
-        while (gte256(&resMod, r)) {
-            if (gte256(&resMod, &copyd)) {
-                sub256(&resMod, &copyd, &resMod);
-                or256(&resDiv, &adder, &resDiv);
-            }
-            shiftr256(&copyd, 1, &copyd);
-            shiftr256(&adder, 1, &adder);
+    uint32_t num[UINT256_WORDS];
+    uint32_t den[UINT256_WORDS];
+    uint32_t quot[UINT256_WORDS];
+    uint32_t rem[UINT256_WORDS];
+
+    u256_to_words(l, num);
+    u256_to_words(r, den);
+    divmod_words(num, den, UINT256_WORDS, quot, rem);
+    words_to_u256(quot, retDiv);
+    words_to_u256(rem, retMod);
+}
+
+/**
+ * Get the decimal digits of a uint256_t
+ *
+ * The number is divided by 10^9 so that each division yields 9 digits which are then
+ * extracted with native 32-bit arithmetic.
+ *
+ * @param[in] number the number
+ * @param[out] digits the digits, most significant first and without a terminating null byte
+ * @return the number of digits
+ */
+static uint32_t u256_decimal_digits(const uint256_t *const number,
+                                    char digits[UINT256_MAX_DIGITS]) {
+    char reversed[UINT256_MAX_DIGITS + DECIMAL_CHUNK_DIGITS];
+    uint32_t words[UINT256_WORDS];
+    uint32_t count;
+    uint32_t length = 0;
+
+    u256_to_words(number, words);
+    count = significant_words(words, UINT256_WORDS);
+    do {
+        uint32_t chunk = divmod_words_small(words, count, DECIMAL_CHUNK_DIVISOR);
+
+        count = significant_words(words, count);
+        // only the most significant chunk does not get padded with zeros
+        for (uint8_t i = 0; (i < DECIMAL_CHUNK_DIGITS) && ((count > 0) || (chunk != 0)); ++i) {
+            reversed[length++] = '0' + (chunk % 10);
+            chunk /= 10;
         }
-        copy256(retDiv, &resDiv);
-        copy256(retMod, &resMod);
+    } while (count > 0);
+    if (length == 0) {
+        reversed[length++] = '0';
+    }
+    for (uint32_t i = 0; i < length; ++i) {
+        digits[i] = reversed[length - 1 - i];
+    }
+    return length;
+}
+
+/**
+ * Format a uint256_t into a decimal string, with an optional decimal point
+ *
+ * Trailing zeros of the fractional part are dropped, and so is the decimal point when
+ * nothing is left after it.
+ *
+ * @param[in] number the number to format
+ * @param[in] decimals the number of digits after the decimal point, 0 for none
+ * @param[out] out the output buffer
+ * @param[in] out_length the length of the output buffer
+ * @return whether the formatting was successful or not
+ */
+bool u256_to_decimal(const uint256_t *const number,
+                     uint8_t decimals,
+                     char *const out,
+                     uint32_t out_length) {
+    char digits[UINT256_MAX_DIGITS];
+    uint32_t length = u256_decimal_digits(number, digits);
+    // digits that belong to the fractional part
+    uint32_t frac_length = MIN(length, decimals);
+    uint32_t int_length = length - frac_length;
+    // zeros between the decimal point and the first digit
+    uint32_t lead_zeros = decimals - frac_length;
+    uint32_t offset = 0;
+
+    while ((frac_length > 0) && (digits[length - 1] == '0')) {
+        length -= 1;
+        frac_length -= 1;
+    }
+    if (frac_length == 0) {
+        lead_zeros = 0;
     }
+    if ((MAX(int_length, 1) + ((frac_length > 0) ? (1 + lead_zeros + frac_length) : 0)) >=
+        out_length) {
+        return false;
+    }
+    if (int_length == 0) {
+        out[offset++] = '0';
+    } else {
+        memcpy(out, digits, int_length);
+        offset += int_length;
+    }
+    if (frac_length > 0) {
+        out[offset++] = '.';
+        memset(out + offset, '0', lead_zeros);
+        offset += lead_zeros;
+        memcpy(out + offset, digits + int_length, frac_length);
+        offset += frac_length;
+    }
+    out[offset] = '\0';
+    return true;
 }
 
 bool tostring256(const uint256_t *const number,
                  uint32_t baseParam,
                  char *const out,
                  uint32_t outLength) {
-    uint256_t rDiv;
-    uint256_t rMod;
-    uint256_t base;
-    copy256(&rDiv, number);
-    clear256(&rMod);
-    clear256(&base);
-    UPPER(LOWER(base)) = 0;
-    LOWER(LOWER(base)) = baseParam;
+    uint32_t words[UINT256_WORDS];
+    uint32_t count;
     uint32_t offset = 0;
     if ((outLength == 0) || (baseParam < 2) || (baseParam > 16)) {
         return false;
     }
-    do {
-        divmod256(&rDiv, &base, &rDiv, &rMod);
-        out[offset++] = HEXDIGITS[(uint8_t) LOWER(LOWER(rMod))];
-    } while (!zero256(&rDiv) && (offset < outLength));
+    if (baseParam == 10) {
+        char digits[UINT256_MAX_DIGITS];
+
+        offset = u256_decimal_digits(number, digits);
+        if (offset < outLength) {
+            memcpy(out, digits, offset);
+            out[offset] = '\0';
+            return true;
+        }
+        offset = outLength;
+    } else {
+        u256_to_words(number, words);
+        count = significant_words(words, UINT256_WORDS);
+        do {
+            out[offset++] = HEXDIGITS[divmod_words_small(words, count, baseParam)];
+            count = significant_words(words, count);
+        } while ((count > 0) && (offset < outLength));
+    }
 
     if (offset == outLength) {  // destination buffer too small
         if (outLength > 3) {
@@ -261,22 +360,16 @@ bool tostring256_signed(const uint256_t *const number,
                         char *const out,
                         uint32_t out_length) {
     uint256_t max_unsigned_val;
-    uint256_t max_signed_val;
     uint256_t one_val;
-    uint256_t two_val;
     uint256_t tmp;
 
     // showing negative numbers only really makes sense in base 10
     if (base == 10) {
-        explicit_bzero(&one_val, sizeof(one_val));
-        LOWER(LOWER(one_val)) = 1;
-        explicit_bzero(&two_val, sizeof(two_val));
-        LOWER(LOWER(two_val)) = 2;
-
-        memset(&max_unsigned_val, 0xFF, sizeof(max_unsigned_val));
-        divmod256(&max_unsigned_val, &two_val, &max_signed_val, &tmp);
-        if (gt256(number, &max_signed_val))  // negative value
+        if (UPPER(UPPER_P(number)) & 0x8000000000000000)  // negative value
         {
+            explicit_bzero(&one_val, sizeof(one_val));
+            LOWER(LOWER(one_val)) = 1;
+            memset(&max_unsigned_val, 0xFF, sizeof(max_unsigned_val));
             sub256(&max_unsigned_val, number, &tmp);
             add256(&tmp, &one_val, &tmp);
             out[0] = '-';
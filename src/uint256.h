@@ -24,6 +24,9 @@
 #include <stdbool.h>
 #include "uint128.h"
 
+// 2^256 - 1 is 78 digits long
+#define UINT256_MAX_DIGITS 78
+
 typedef struct uint256_t {
     uint128_t elements[2];
 } uint256_t;
@@ -57,6 +60,10 @@ bool tostring256_signed(const uint256_t *const number,
                         uint32_t base,
                         char *const out,
                         uint32_t out_length);
+bool u256_to_decimal(const uint256_t *const number,
+                     uint8_t decimals,
+                     char *const out,
+                     uint32_t out_length);
 void convertUint256BE(const uint8_t *const data, uint32_t length, uint256_t *const target);
 
 #endif  // _UINT256_H_
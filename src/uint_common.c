@@ -58,3 +58,130 @@ void reverseString(char *const str, uint32_t length) {
         str[j] = c;
     }
 }
+
+/**
+ * Get the number of words of a number once its leading zero words are dropped
+ *
+ * @param[in] words the number, as little-endian 32-bit words
+ * @param[in] count the number of words
+ * @return the number of significant words, 0 if the number is zero
+ */
+uint32_t significant_words(const uint32_t *const words, uint32_t count) {
+    while ((count > 0) && (words[count - 1] == 0)) {
+        count -= 1;
+    }
+    return count;
+}
+
+/**
+ * Divide a number by a single word, in place
+ *
+ * @param[in,out] words the dividend as little-endian 32-bit words, replaced by the quotient
+ * @param[in] count the number of words
+ * @param[in] divisor the divisor, must not be zero
+ * @return the remainder
+ */
+uint32_t divmod_words_small(uint32_t *const words, uint32_t count, uint32_t divisor) {
+    uint64_t rem = 0;
+
+    for (uint32_t i = count; i-- > 0;) {
+        uint64_t cur = (rem << 32) | words[i];
+        words[i] = (uint32_t) (cur / divisor);
+        rem = cur % divisor;
+    }
+    return (uint32_t) rem;
+}
+
+/**
+ * Long division on 32-bit words (Knuth, TAOCP vol. 2, 4.3.1, algorithm D)
+ *
+ * A division by zero yields a zero quotient and the dividend as remainder.
+ *
+ * @param[in] num the dividend, as little-endian 32-bit words
+ * @param[in] den the divisor, as little-endian 32-bit words
+ * @param[in] count the number of words of all the operands, at most UINT256_WORDS
+ * @param[out] quot the quotient, must not overlap the operands
+ * @param[out] rem the remainder, must not overlap the operands
+ */
+void divmod_words(const uint32_t *const num,
+                  const uint32_t *const den,
+                  uint32_t count,
+                  uint32_t *const quot,
+                  uint32_t *const rem) {
+    uint32_t un[UINT256_WORDS + 1];
+    uint32_t vn[UINT256_WORDS];
+    uint32_t m = significant_words(num, count);
+    uint32_t n = significant_words(den, count);
+    uint32_t shift;
+
+    memset(quot, 0, count * sizeof(*quot));
+    memset(rem, 0, count * sizeof(*rem));
+    if ((n == 0) || (m < n)) {
+        memmove(rem, num, count * sizeof(*rem));
+        return;
+    }
+    if (n == 1) {
+        memmove(quot, num, m * sizeof(*quot));
+        rem[0] = divmod_words_small(quot, m, den[0]);
+        return;
+    }
+
+    // normalize so that the top word of the divisor has its most significant bit set
+    shift = __builtin_clz(den[n - 1]);
+    for (uint32_t i = n - 1; i > 0; --i) {
+        vn[i] = (den[i] << shift) | (shift ? (den[i - 1] >> (32 - shift)) : 0);
+    }
+    vn[0] = den[0] << shift;
+    un[m] = shift ? (num[m - 1] >> (32 - shift)) : 0;
+    for (uint32_t i = m - 1; i > 0; --i) {
+        un[i] = (num[i] << shift) | (shift ? (num[i - 1] >> (32 - shift)) : 0);
+    }
+    un[0] = num[0] << shift;
+
+    for (uint32_t j = m - n + 1; j-- > 0;) {
+        uint64_t top = ((uint64_t) un[j + n] << 32) | un[j + n - 1];
+        uint64_t qhat = top / vn[n - 1];
+        uint64_t rhat = top % vn[n - 1];
+        int64_t borrow = 0;
+        int64_t t;
+
+        // estimate is at most 2 too large
+        while ((qhat > UINT32_MAX) || ((qhat * vn[n - 2]) > ((rhat << 32) | un[j + n - 2]))) {
+            qhat -= 1;
+            rhat += vn[n - 1];
+            if (rhat > UINT32_MAX) {
+                break;
+            }
+        }
+
+        // multiply and subtract
+        for (uint32_t i = 0; i < n; ++i) {
+            uint64_t p = qhat * vn[i];
+            t = (int64_t) un[i + j] - borrow - (int64_t) (p & UINT32_MAX);
+            un[i + j] = (uint32_t) t;
+            borrow = (int64_t) (p >> 32) - (t >> 32);
+        }
+        t = (int64_t) un[j + n] - borrow;
+        un[j + n] = (uint32_t) t;
+
+        quot[j] = (uint32_t) qhat;
+        if (t < 0) {
+            // subtracted too much, add back
+            uint64_t carry = 0;
+
+            quot[j] -= 1;
+            for (uint32_t i = 0; i < n; ++i) {
+                carry += (uint64_t) un[i + j] + vn[i];
+                un[i + j] = (uint32_t) carry;
+                carry >>= 32;
+            }
+            un[j + n] += (uint32_t) carry;
+        }
+    }
+
+    // unnormalize the remainder
+    for (uint32_t i = 0; i < n - 1; ++i) {
+        rem[i] = (un[i] >> shift) | (shift ? (un[i + 1] << (32 - shift)) : 0);
+    }
+    rem[n - 1] = un[n - 1] >> shift;
+}
@@ -30,9 +30,20 @@
 #define UPPER(x)   x.elements[0]
 #define LOWER(x)   x.elements[1]
 
+// Number of little-endian 32-bit words used by the division engine
+#define UINT128_WORDS 4
+#define UINT256_WORDS 8
+
 void write_u64_be(uint8_t *const buffer, uint64_t value);
 void read_u64_be(const uint8_t *const in, uint64_t *const out);
 uint64_t readUint64BE(const uint8_t *const buffer);
 void reverseString(char *const str, uint32_t length);
+uint32_t significant_words(const uint32_t *const words, uint32_t count);
+uint32_t divmod_words_small(uint32_t *const words, uint32_t count, uint32_t divisor);
+void divmod_words(const uint32_t *const num,
+                  const uint32_t *const den,
+                  uint32_t count,
+                  uint32_t *const quot,
+                  uint32_t *const rem);
 
 #endif  //_UINT_COMMON_H_
@@ -49,6 +49,78 @@ void getEth2PublicKey(uint32_t *bip32Path, uint8_t bip32PathLength, uint8_t *out
     memmove(out, publicKey.W + 1, 48);
 }
 
+#define BATCH_KEY_SIZE          48
+#define BATCH_MAX_KEYS_PER_APDU 5
+
+typedef struct {
+    bip32_path_t path;
+    uint8_t level;  // index in the path of the component that is incremented
+    uint8_t remaining;
+} s_eth2_pubkey_batch;
+
+static s_eth2_pubkey_batch batch;
+
+/**
+ * Fill the response with the next keys of the batch
+ *
+ * @return the response length
+ */
+static uint32_t set_result_get_eth2_public_key_batch(void) {
+    uint32_t tx = 1;
+    uint8_t count = MIN(batch.remaining, BATCH_MAX_KEYS_PER_APDU);
+
+    G_io_apdu_buffer[0] = count;
+    for (uint8_t i = 0; i < count; ++i) {
+        getEth2PublicKey(batch.path.path, batch.path.length, &G_io_apdu_buffer[tx]);
+        tx += BATCH_KEY_SIZE;
+        batch.path.path[batch.level] += 1;
+        batch.remaining -= 1;
+    }
+    return tx;
+}
+
+/**
+ * Handle the batched, non-confirm, derivation of public keys over a range of indices
+ *
+ * The first APDU gives a path, which of its components is incremented and the amount of keys.
+ * Each response contains as many keys as can fit, the rest is retrieved with subsequent
+ * \ref P1_BATCH_NEXT APDUs.
+ *
+ * @param[in] p1 \ref P1_BATCH_FIRST or \ref P1_BATCH_NEXT
+ * @param[in] dataBuffer APDU payload
+ * @param[in] dataLength payload length
+ * @param[out] tx response length
+ */
+static void handle_get_eth2_public_key_batch(uint8_t p1,
+                                             const uint8_t *dataBuffer,
+                                             uint8_t dataLength,
+                                             unsigned int *tx) {
+    uint32_t last_index;
+
+    if (p1 == P1_BATCH_FIRST) {
+        batch.remaining = 0;
+        dataBuffer = parseBip32(dataBuffer, &dataLength, &batch.path);
+        if ((dataBuffer == NULL) || (dataLength != 2)) {
+            THROW(0x6a80);
+        }
+        batch.level = dataBuffer[0];
+        if ((batch.level >= batch.path.length) || (dataBuffer[1] == 0)) {
+            THROW(0x6a80);
+        }
+        // the incremented component cannot wrap around
+        last_index = batch.path.path[batch.level] + dataBuffer[1] - 1;
+        if (last_index < batch.path.path[batch.level]) {
+            THROW(0x6a80);
+        }
+        batch.remaining = dataBuffer[1];
+    } else if ((dataLength > 0) || (batch.remaining == 0)) {
+        PRINTF("Error: No public key batch in progress!\n");
+        THROW(0x6985);
+    }
+    *tx = set_result_get_eth2_public_key_batch();
+    THROW(0x9000);
+}
+
 void handleGetEth2PublicKey(uint8_t p1,
                             uint8_t p2,
                             const uint8_t *dataBuffer,
@@ -60,10 +132,14 @@ void handleGetEth2PublicKey(uint8_t p1,
     if (!G_called_from_swap) {
         reset_app_context();
     }
-    if ((p1 != P1_CONFIRM) && (p1 != P1_NON_CONFIRM)) {
+    if (p2 != 0) {
         THROW(0x6B00);
     }
-    if (p2 != 0) {
+    if ((p1 == P1_BATCH_FIRST) || (p1 == P1_BATCH_NEXT)) {
+        handle_get_eth2_public_key_batch(p1, dataBuffer, dataLength, tx);
+    }
+    batch.remaining = 0;
+    if ((p1 != P1_CONFIRM) && (p1 != P1_NON_CONFIRM)) {
         THROW(0x6B00);
     }
 
@@ -0,0 +1,136 @@
+#ifdef HAVE_MEM_STATS
+
+#include "shared_context.h"
+#include "apdu_constants.h"
+#include "mem.h"
+#include "manage_asset_info.h"
+#include "sig_cache.h"
+#include "plugin_selectors.h"
+
+#define P1_MEM_STATS_READ       0x00
+#define P1_MEM_STATS_READ_RESET 0x01
+
+#define P2_MEM_STATS_BUFFER      0x00
+#define P2_MEM_STATS_ASSET_CACHE 0x01
+#define P2_MEM_STATS_SIG_CACHE   0x02
+#define P2_MEM_STATS_SELECTORS   0x03
+
+/**
+ * Write the usage statistics of the memory buffer to the APDU buffer
+ *
+ * @param[in] reset whether the statistics should be reset once read
+ * @return the length of the written data
+ */
+static unsigned int get_buffer_stats(bool reset) {
+    const s_mem_stats *stats = mem_get_stats();
+    unsigned int offset = 0;
+
+    U2BE_ENCODE(G_io_apdu_buffer, offset, stats->size);
+    offset += sizeof(uint16_t);
+    U2BE_ENCODE(G_io_apdu_buffer, offset, stats->used);
+    offset += sizeof(uint16_t);
+    U2BE_ENCODE(G_io_apdu_buffer, offset, stats->peak);
+    offset += sizeof(uint16_t);
+    G_io_apdu_buffer[offset++] = stats->peak_tag;
+    G_io_apdu_buffer[offset++] = MEM_TAG_COUNT;
+    for (uint8_t tag = 0; tag < MEM_TAG_COUNT; ++tag) {
+        U4BE_ENCODE(G_io_apdu_buffer, offset, stats->allocated[tag]);
+        offset += sizeof(uint32_t);
+    }
+    if (reset) {
+        mem_reset_stats();
+    }
+    return offset;
+}
+
+/**
+ * Write the occupancy of the asset-info cache to the APDU buffer
+ *
+ * @return the length of the written data
+ */
+static unsigned int get_asset_cache_stats(void) {
+    unsigned int offset = 0;
+
+    G_io_apdu_buffer[offset++] = get_known_assets_count();
+    G_io_apdu_buffer[offset++] = MAX_ASSETS;
+    return offset;
+}
+
+/**
+ * Write the hit & miss counters of the signature cache to the APDU buffer
+ *
+ * @param[in] reset whether the counters should be reset once read
+ * @return the length of the written data
+ */
+static unsigned int get_sig_cache_stats(bool reset) {
+    const sig_cache_stats_t *stats = sig_cache_get_stats();
+    unsigned int offset = 0;
+
+    U4BE_ENCODE(G_io_apdu_buffer, offset, stats->hits);
+    offset += sizeof(uint32_t);
+    U4BE_ENCODE(G_io_apdu_buffer, offset, stats->misses);
+    offset += sizeof(uint32_t);
+    if (reset) {
+        sig_cache_reset_stats();
+    }
+    return offset;
+}
+
+/**
+ * Write the number of times each selector of the internal plugins has been matched to the
+ * APDU buffer
+ *
+ * @param[in] reset whether the counters should be reset once read
+ * @return the length of the written data
+ */
+static unsigned int get_selector_stats(bool reset) {
+    const plugin_selector_t *table = PIC(g_plugin_selectors);
+    const uint16_t *hits = get_plugin_selector_hits();
+    unsigned int offset = 0;
+
+    G_io_apdu_buffer[offset++] = g_plugin_selectors_count;
+    for (size_t i = 0; i < g_plugin_selectors_count; ++i) {
+        U4BE_ENCODE(G_io_apdu_buffer, offset, table[i].selector);
+        offset += sizeof(uint32_t);
+        G_io_apdu_buffer[offset++] = table[i].plugin;
+        U2BE_ENCODE(G_io_apdu_buffer, offset, hits[i]);
+        offset += sizeof(uint16_t);
+    }
+    if (reset) {
+        reset_plugin_selector_hits();
+    }
+    return offset;
+}
+
+void handleGetMemStats(uint8_t p1,
+                       uint8_t p2,
+                       const uint8_t *workBuffer,
+                       uint8_t dataLength,
+                       unsigned int *flags,
+                       unsigned int *tx) {
+    UNUSED(workBuffer);
+    UNUSED(dataLength);
+    UNUSED(flags);
+    if ((p1 != P1_MEM_STATS_READ) && (p1 != P1_MEM_STATS_READ_RESET)) {
+        THROW(APDU_RESPONSE_INVALID_P1_P2);
+    }
+    switch (p2) {
+        case P2_MEM_STATS_BUFFER:
+            *tx = get_buffer_stats(p1 == P1_MEM_STATS_READ_RESET);
+            break;
+        case P2_MEM_STATS_ASSET_CACHE:
+            *tx = get_asset_cache_stats();
+            break;
+        case P2_MEM_STATS_SIG_CACHE:
+            *tx = get_sig_cache_stats(p1 == P1_MEM_STATS_READ_RESET);
+            break;
+        case P2_MEM_STATS_SELECTORS:
+            *tx = get_selector_stats(p1 == P1_MEM_STATS_READ_RESET);
+            break;
+        default:
+            THROW(APDU_RESPONSE_INVALID_P1_P2);
+    }
+    THROW(APDU_RESPONSE_OK);
+}
+
+#endif  // HAVE_MEM_STATS
@@ -5,6 +5,173 @@
 #include "common_ui.h"
 #include "os_io_seproxyhal.h"
 #include "crypto_helpers.h"
+#include "derived_key_cache.h"
+
+// compressed public key & binary address
+#define BATCH_ENTRY_SIZE        (33 + ADDRESS_LENGTH)
+#define BATCH_MAX_KEYS_PER_APDU 4
+#define HARDENED_INDEX          0x80000000
+
+typedef struct {
+    bip32_path_t path;  // base path, the child index is appended to it
+    uint8_t parent_pubkey[65];
+    uint8_t parent_chain_code[32];
+    uint32_t next_index;
+    uint8_t remaining;
+} s_pubkey_batch;
+
+static s_pubkey_batch batch;
+
+static const uint8_t SECP256K1_ORDER[32] = {
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xfe,
+    0xba, 0xae, 0xdc, 0xe6, 0xaf, 0x48, 0xa0, 0x3b, 0xbf, 0xd2, 0x5e, 0x8c, 0xd0, 0x36, 0x41, 0x41};
+
+/**
+ * Derive the public key of a child of the batch parent node from the seed
+ *
+ * @param[in] index child index
+ * @param[out] raw_pubkey uncompressed public key
+ * @return whether it was successful
+ */
+static bool batch_derive_child_from_seed(uint32_t index, uint8_t raw_pubkey[static 65]) {
+    batch.path.path[batch.path.length] = index;
+    return bip32_derive_get_pubkey_256(CX_CURVE_256K1,
+                                       batch.path.path,
+                                       batch.path.length + 1,
+                                       raw_pubkey,
+                                       NULL,
+                                       CX_SHA512) == CX_OK;
+}
+
+/**
+ * Derive the public key of a child of the batch parent node
+ *
+ * Non-hardened children are derived from the parent public key & chain code (BIP32 CKDpub),
+ * which only costs an HMAC, a base point multiplication and a point addition. Hardened ones
+ * and the (astronomically unlikely) invalid tweaks go through a full derivation from the seed.
+ *
+ * @param[in] index child index
+ * @param[out] raw_pubkey uncompressed public key
+ * @return whether it was successful
+ */
+static bool batch_derive_child(uint32_t index, uint8_t raw_pubkey[static 65]) {
+    uint8_t data[33 + sizeof(index)];
+    uint8_t tweak[64];
+    cx_ecfp_private_key_t tweak_privkey;
+    cx_ecfp_public_key_t tweak_pubkey;
+    int diff;
+
+    if (index & HARDENED_INDEX) {
+        return batch_derive_child_from_seed(index, raw_pubkey);
+    }
+    // compressed parent public key || index
+    data[0] = (batch.parent_pubkey[64] & 1) ? 0x03 : 0x02;
+    memcpy(&data[1], &batch.parent_pubkey[1], 32);
+    U4BE_ENCODE(data, 33, index);
+    cx_hmac_sha512(batch.parent_chain_code,
+                   sizeof(batch.parent_chain_code),
+                   data,
+                   sizeof(data),
+                   tweak,
+                   sizeof(tweak));
+    // only the left half matters here, the right one being the child chain code
+    if ((cx_math_cmp_no_throw(tweak, SECP256K1_ORDER, 32, &diff) != CX_OK) || (diff >= 0) ||
+        (cx_ecfp_init_private_key_no_throw(CX_CURVE_256K1, tweak, 32, &tweak_privkey) != CX_OK) ||
+        (cx_ecfp_generate_pair_no_throw(CX_CURVE_256K1, &tweak_pubkey, &tweak_privkey, 1) !=
+         CX_OK) ||
+        (cx_ecfp_add_point_no_throw(CX_CURVE_256K1,
+                                    raw_pubkey,
+                                    tweak_pubkey.W,
+                                    batch.parent_pubkey) != CX_OK)) {
+        return batch_derive_child_from_seed(index, raw_pubkey);
+    }
+    return true;
+}
+
+/**
+ * Fill the response with the next keys of the batch
+ *
+ * @return the response length
+ */
+static uint32_t set_result_get_public_key_batch(void) {
+    uint8_t raw_pubkey[65];
+    uint32_t tx = 1;
+    uint8_t count = MIN(batch.remaining, BATCH_MAX_KEYS_PER_APDU);
+
+    G_io_apdu_buffer[0] = count;
+    for (uint8_t i = 0; i < count; ++i) {
+        if (!batch_derive_child(batch.next_index, raw_pubkey)) {
+            batch.remaining = 0;
+            THROW(APDU_RESPONSE_UNKNOWN);
+        }
+        G_io_apdu_buffer[tx] = (raw_pubkey[64] & 1) ? 0x03 : 0x02;
+        memcpy(&G_io_apdu_buffer[tx + 1], &raw_pubkey[1], 32);
+        getEthAddressFromRawKey(raw_pubkey, &G_io_apdu_buffer[tx + 33]);
+        tx += BATCH_ENTRY_SIZE;
+        batch.next_index += 1;
+        batch.remaining -= 1;
+    }
+    return tx;
+}
+
+/**
+ * Handle the batched, non-confirm, derivation of consecutive public keys
+ *
+ * The first APDU gives the parent path, the first child index and the amount of keys, the
+ * parent node is derived once. Each response contains as many keys as can fit, the rest is
+ * retrieved with subsequent \ref P1_BATCH_NEXT APDUs.
+ *
+ * @param[in] p1 \ref P1_BATCH_FIRST or \ref P1_BATCH_NEXT
+ * @param[in] p2 must be \ref P2_NO_CHAINCODE
+ * @param[in] dataBuffer APDU payload
+ * @param[in] dataLength payload length
+ * @param[out] tx response length
+ */
+static void handle_get_public_key_batch(uint8_t p1,
+                                        uint8_t p2,
+                                        const uint8_t *dataBuffer,
+                                        uint8_t dataLength,
+                                        unsigned int *tx) {
+    uint32_t first_index;
+    uint8_t count;
+
+    if (p2 != P2_NO_CHAINCODE) {
+        PRINTF("Error: Unexpected P2 (%u)!\n", p2);
+        THROW(APDU_RESPONSE_INVALID_P1_P2);
+    }
+    if (p1 == P1_BATCH_FIRST) {
+        batch.remaining = 0;
+        dataBuffer = parseBip32(dataBuffer, &dataLength, &batch.path);
+        if ((dataBuffer == NULL) || (batch.path.length >= MAX_BIP32_PATH) ||
+            (dataLength != (sizeof(first_index) + sizeof(count)))) {
+            THROW(APDU_RESPONSE_INVALID_DATA);
+        }
+        first_index = U4BE(dataBuffer, 0);
+        count = dataBuffer[sizeof(first_index)];
+        // the range cannot wrap around nor straddle the hardened boundary
+        if ((count == 0) ||
+            ((first_index & HARDENED_INDEX) !=
+             ((first_index + count - 1) & HARDENED_INDEX)) ||
+            ((first_index + count - 1) < first_index)) {
+            THROW(APDU_RESPONSE_INVALID_DATA);
+        }
+        if (bip32_derive_get_pubkey_256(CX_CURVE_256K1,
+                                        batch.path.path,
+                                        batch.path.length,
+                                        batch.parent_pubkey,
+                                        batch.parent_chain_code,
+                                        CX_SHA512) != CX_OK) {
+            THROW(APDU_RESPONSE_UNKNOWN);
+        }
+        batch.next_index = first_index;
+        batch.remaining = count;
+    } else if ((dataLength > 0) || (batch.remaining == 0)) {
+        PRINTF("Error: No public key batch in progress!\n");
+        THROW(APDU_RESPONSE_CONDITION_NOT_SATISFIED);
+    }
+    *tx = set_result_get_public_key_batch();
+    THROW(APDU_RESPONSE_OK);
+}
 
 void handleGetPublicKey(uint8_t p1,
                         uint8_t p2,
@@ -13,11 +180,18 @@ void handleGetPublicKey(uint8_t p1,
                         unsigned int *flags,
                         unsigned int *tx) {
     bip32_path_t bip32;
+#ifndef TARGET_NANOS
+    const derived_key_t *key;
+#endif
 
     if (!G_called_from_swap) {
         reset_app_context();
     }
 
+    if ((p1 == P1_BATCH_FIRST) || (p1 == P1_BATCH_NEXT)) {
+        handle_get_public_key_batch(p1, p2, dataBuffer, dataLength, tx);
+    }
+    batch.remaining = 0;
     if ((p1 != P1_CONFIRM) && (p1 != P1_NON_CONFIRM)) {
         PRINTF("Error: Unexpected P1 (%u)!\n", p1);
         THROW(APDU_RESPONSE_INVALID_P1_P2);
@@ -34,6 +208,7 @@ void handleGetPublicKey(uint8_t p1,
     }
 
     tmpCtx.publicKeyContext.getChaincode = (p2 == P2_CHAINCODE);
+#ifdef TARGET_NANOS
     if (bip32_derive_get_pubkey_256(
             CX_CURVE_256K1,
             bip32.path,
@@ -46,6 +221,16 @@ void handleGetPublicKey(uint8_t p1,
     getEthAddressStringFromRawKey(tmpCtx.publicKeyContext.publicKey.W,
                                   tmpCtx.publicKeyContext.address,
                                   chainConfig->chainId);
+#else
+    if ((key = get_derived_key(bip32.path, bip32.length, chainConfig->chainId)) == NULL) {
+        THROW(APDU_RESPONSE_UNKNOWN);
+    }
+    memcpy(tmpCtx.publicKeyContext.publicKey.W, key->raw_pubkey, sizeof(key->raw_pubkey));
+    memcpy(tmpCtx.publicKeyContext.address, key->address_str, sizeof(key->address_str));
+    if (tmpCtx.publicKeyContext.getChaincode) {
+        memcpy(tmpCtx.publicKeyContext.chainCode, key->chain_code, sizeof(key->chain_code));
+    }
+#endif
 
     uint64_t chain_id = chainConfig->chainId;
     if (dataLength >= sizeof(chain_id)) {
@@ -384,6 +384,7 @@ static bool verify_signature(const s_sig_ctx *sig_ctx) {
             PRINTF("Error: Unknown metadata key ID %u\n", sig_ctx->key_id);
             return false;
     }
+    // not going through the signature cache, the payload being bound to a fresh challenge
     if (!cx_ecdsa_verify_no_throw(&verif_key,
                                   hash,
                                   sizeof(hash),
@@ -607,7 +608,11 @@ static bool parse_tlv(const s_tlv_payload *payload,
  * @return whether it was successful
  */
 static bool alloc_payload(s_tlv_payload *payload, uint16_t size) {
-    if ((payload->buf = mem_alloc(size)) == NULL) {
+    e_mem_tag tag = mem_set_tag(MEM_TAG_TLV_PAYLOAD);
+
+    payload->buf = mem_alloc(size);
+    mem_set_tag(tag);
+    if (payload->buf == NULL) {
         apdu_response_code = APDU_RESPONSE_INSUFFICIENT_MEMORY;
         return false;
     }
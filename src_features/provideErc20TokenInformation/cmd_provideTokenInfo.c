@@ -6,6 +6,7 @@
 #include "extra_tokens.h"
 #include "network.h"
 #include "manage_asset_info.h"
+#include "sig_cache.h"
 
 #ifdef HAVE_CONTRACT_NAME_IN_DESCRIPTOR
 
@@ -27,7 +28,7 @@ void handleProvideErc20TokenInformation(uint8_t p1,
 
     cx_sha256_init(&sha256);
 
-    tokenDefinition_t *token = &get_current_asset_info()->token;
+    tokenDefinition_t *token = &reserve_asset_slot()->token;
 
     if (dataLength < 1) {
         THROW(0x6A80);
@@ -93,7 +94,7 @@ void handleProvideErc20TokenInformation(uint8_t p1,
         THROW(0x6A80);
 #endif
     }
-    validate_current_asset_info();
+    validate_current_asset_info(chainId);
     THROW(0x9000);
 }
 
@@ -113,9 +114,8 @@ void handleProvideErc20TokenInformation(uint8_t p1,
     uint8_t tickerLength;
     uint64_t chain_id;
     uint8_t hash[INT256_LENGTH];
-    cx_ecfp_public_key_t tokenKey;
 
-    tokenDefinition_t *token = &get_current_asset_info()->token;
+    tokenDefinition_t *token = &reserve_asset_slot()->token;
 
     PRINTF("Provisioning currentAssetIndex %d\n", tmpCtx.transactionContext.currentAssetIndex);
 
@@ -167,11 +167,12 @@ void handleProvideErc20TokenInformation(uint8_t p1,
     } else
 #endif
     {
-        CX_ASSERT(cx_ecfp_init_public_key_no_throw(CX_CURVE_256K1,
-                                                   LEDGER_SIGNATURE_PUBLIC_KEY,
-                                                   sizeof(LEDGER_SIGNATURE_PUBLIC_KEY),
-                                                   &tokenKey));
-        if (!cx_ecdsa_verify_no_throw(&tokenKey, hash, 32, workBuffer + offset, dataLength)) {
+        if (!sig_cache_verify(LEDGER_SIGNATURE_PUBLIC_KEY,
+                              sizeof(LEDGER_SIGNATURE_PUBLIC_KEY),
+                              hash,
+                              32,
+                              workBuffer + offset,
+                              dataLength)) {
 #ifndef HAVE_BYPASS_SIGNATURES
             PRINTF("Invalid token signature\n");
             THROW(0x6A80);
@@ -180,7 +181,7 @@ void handleProvideErc20TokenInformation(uint8_t p1,
     }
 
     G_io_apdu_buffer[0] = tmpCtx.transactionContext.currentAssetIndex;
-    validate_current_asset_info();
+    validate_current_asset_info(chain_id);
     U2BE_ENCODE(G_io_apdu_buffer, 1, APDU_RESPONSE_OK);
     io_exchange(CHANNEL_APDU | IO_RETURN_AFTER_TX, 3);
 }
@@ -9,6 +9,7 @@
 #include "network.h"
 #include "public_keys.h"
 #include "manage_asset_info.h"
+#include "sig_cache.h"
 
 #define TYPE_SIZE        1
 #define VERSION_SIZE     1
@@ -50,14 +51,13 @@ void handleProvideNFTInformation(uint8_t p1,
     UNUSED(tx);
     UNUSED(flags);
     uint8_t hash[INT256_LENGTH];
-    cx_ecfp_public_key_t nftKey;
     PRINTF("In handle provide NFTInformation\n");
 
     if ((pluginType != ERC721) && (pluginType != ERC1155)) {
         PRINTF("NFT metadata provided without proper plugin loaded!\n");
         THROW(0x6985);
     }
-    nftInfo_t *nft = &get_current_asset_info()->nft;
+    nftInfo_t *nft = &reserve_asset_slot()->nft;
 
     PRINTF("Provisioning currentAssetIndex %d\n", tmpCtx.transactionContext.currentAssetIndex);
 
@@ -187,12 +187,12 @@ void handleProvideNFTInformation(uint8_t p1,
         THROW(APDU_RESPONSE_INVALID_DATA);
     }
 
-    CX_ASSERT(cx_ecfp_init_public_key_no_throw(CX_CURVE_256K1, rawKey, rawKeyLen, &nftKey));
-    if (!cx_ecdsa_verify_no_throw(&nftKey,
-                                  hash,
-                                  sizeof(hash),
-                                  (uint8_t *) workBuffer + offset,
-                                  signatureLen)) {
+    if (!sig_cache_verify(rawKey,
+                          rawKeyLen,
+                          hash,
+                          sizeof(hash),
+                          (uint8_t *) workBuffer + offset,
+                          signatureLen)) {
 #ifndef HAVE_BYPASS_SIGNATURES
         PRINTF("Invalid NFT signature\n");
         THROW(APDU_RESPONSE_INVALID_DATA);
@@ -200,7 +200,7 @@ void handleProvideNFTInformation(uint8_t p1,
     }
 
     G_io_apdu_buffer[0] = tmpCtx.transactionContext.currentAssetIndex;
-    validate_current_asset_info();
+    validate_current_asset_info(chain_id);
     U2BE_ENCODE(G_io_apdu_buffer, 1, APDU_RESPONSE_OK);
     io_exchange(CHANNEL_APDU | IO_RETURN_AFTER_TX, 3);
 }
@@ -1,6 +1,7 @@
 #include "shared_context.h"
 #include "apdu_constants.h"
 #include "public_keys.h"
+#include "sig_cache.h"
 #include "eth_plugin_interface.h"
 #include "eth_plugin_internal.h"
 #include "plugin_utils.h"
@@ -18,7 +19,6 @@ void handleSetExternalPlugin(uint8_t p1,
     UNUSED(flags);
     PRINTF("Handling set Plugin\n");
     uint8_t hash[INT256_LENGTH];
-    cx_ecfp_public_key_t tokenKey;
     uint8_t pluginNameLength = *workBuffer;
     PRINTF("plugin Name Length: %d\n", pluginNameLength);
     const size_t payload_size = 1 + pluginNameLength + ADDRESS_LENGTH + SELECTOR_SIZE;
@@ -37,15 +37,12 @@ void handleSetExternalPlugin(uint8_t p1,
 
     // check Ledger's signature over the payload
     cx_hash_sha256(workBuffer, payload_size, hash, sizeof(hash));
-    CX_ASSERT(cx_ecfp_init_public_key_no_throw(CX_CURVE_256K1,
-                                               LEDGER_SIGNATURE_PUBLIC_KEY,
-                                               sizeof(LEDGER_SIGNATURE_PUBLIC_KEY),
-                                               &tokenKey));
-    if (!cx_ecdsa_verify_no_throw(&tokenKey,
-                                  hash,
-                                  sizeof(hash),
-                                  workBuffer + payload_size,
-                                  dataLength - payload_size)) {
+    if (!sig_cache_verify(LEDGER_SIGNATURE_PUBLIC_KEY,
+                          sizeof(LEDGER_SIGNATURE_PUBLIC_KEY),
+                          hash,
+                          sizeof(hash),
+                          workBuffer + payload_size,
+                          dataLength - payload_size)) {
 #ifndef HAVE_BYPASS_SIGNATURES
         PRINTF("Invalid plugin signature %.*H\n",
                dataLength - payload_size,
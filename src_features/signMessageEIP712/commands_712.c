@@ -10,6 +10,7 @@
 #include "path.h"
 #include "ui_logic.h"
 #include "typed_data.h"
+#include "mem.h"
 #include "schema_hash.h"
 #include "filtering.h"
 #include "common_712.h"
@@ -23,16 +24,41 @@
 // APDUs P2
 #define P2_DEF_NAME               0x00
 #define P2_DEF_FIELD              0xFF
+#define P2_DEF_BATCH              0xFE
 #define P2_IMPL_NAME              P2_DEF_NAME
 #define P2_IMPL_ARRAY             0x0F
 #define P2_IMPL_FIELD             P2_DEF_FIELD
+#define P2_IMPL_FIELDS            0xFE
 #define P2_FILT_ACTIVATE          0x00
+#define P2_FILT_MESSAGE_MANIFEST  0x0E
 #define P2_FILT_MESSAGE_INFO      0x0F
 #define P2_FILT_DATE_TIME         0xFC
 #define P2_FILT_AMOUNT_JOIN_TOKEN 0xFD
 #define P2_FILT_AMOUNT_JOIN_VALUE 0xFE
 #define P2_FILT_RAW_FIELD         0xFF
 
+/**
+ * State of a batched struct implementation command paused on a displayed value
+ *
+ * The remaining values are not copied: data points into G_io_apdu_buffer, which holds the batched
+ * APDU until its reply. Nothing may write to that buffer while the UI is paused on one of its
+ * values. The reply status word is written in handle_eip712_return_code only once the last
+ * value is done, and no new APDU can be received until that deferred reply has been sent.
+ */
+typedef struct {
+    // remaining field values of the batched APDU, in G_io_apdu_buffer
+    const uint8_t *data;
+    uint8_t length;
+    // whether the values are currently being processed
+    bool running;
+    // whether the last processed value is done with (nothing to display)
+    bool field_done;
+} s_impl_batch;
+
+static s_impl_batch impl_batch = {0};
+
+static bool struct_impl_batch_process(void);
+
 /**
  * Send the response to the previous APDU command
  *
@@ -42,6 +68,16 @@
  * @param[in] success whether the command was successful
  */
 void handle_eip712_return_code(bool success) {
+    if (success && (impl_batch.length > 0)) {
+        // more field values to process before replying
+        if (impl_batch.running) {
+            impl_batch.field_done = true;
+        } else if (!struct_impl_batch_process()) {
+            handle_eip712_return_code(false);
+        }
+        return;
+    }
+    impl_batch.length = 0;
     if (success) {
         apdu_response_code = APDU_RESPONSE_OK;
     } else if (apdu_response_code == APDU_RESPONSE_OK) {  // somehow not set
@@ -60,6 +96,56 @@ void handle_eip712_return_code(bool success) {
     }
 }
 
+/**
+ * Process a batch of struct definition entries
+ *
+ * Each entry is made of the P2 of its unitary command, a length and the matching data.
+ *
+ * @param[in] data the entries
+ * @param[in] length the entries length
+ * @return whether the definitions were successful or not
+ */
+static bool struct_def_batch(const uint8_t *const data, uint8_t length) {
+    uint8_t offset = 0;
+    uint8_t entry_type;
+    uint8_t entry_length;
+    bool ret;
+
+    if (length == 0) {
+        apdu_response_code = APDU_RESPONSE_INVALID_DATA;
+        return false;
+    }
+    while (offset < length) {
+        if ((offset + sizeof(entry_type) + sizeof(entry_length)) > length) {
+            apdu_response_code = APDU_RESPONSE_INVALID_DATA;
+            return false;
+        }
+        entry_type = data[offset++];
+        entry_length = data[offset++];
+        if ((offset + entry_length) > length) {
+            apdu_response_code = APDU_RESPONSE_INVALID_DATA;
+            return false;
+        }
+        switch (entry_type) {
+            case P2_DEF_NAME:
+                ret = set_struct_name(entry_length, &data[offset]);
+                break;
+            case P2_DEF_FIELD:
+                ret = set_struct_field(entry_length, &data[offset]);
+                break;
+            default:
+                PRINTF("Unknown struct definition entry type 0x%x\n", entry_type);
+                apdu_response_code = APDU_RESPONSE_INVALID_DATA;
+                ret = false;
+        }
+        if (!ret) {
+            return false;
+        }
+        offset += entry_length;
+    }
+    return true;
+}
+
 /**
  * Process the EIP712 struct definition command
  *
@@ -68,10 +154,12 @@ void handle_eip712_return_code(bool success) {
  */
 bool handle_eip712_struct_def(const uint8_t *const apdu_buf) {
     bool ret = true;
+    e_mem_tag tag;
 
     if (eip712_context == NULL) {
         ret = eip712_context_init();
     }
+    tag = mem_set_tag(MEM_TAG_EIP712_TYPED_DATA);
 
     if (struct_state == DEFINED) {
         ret = false;
@@ -85,6 +173,9 @@ bool handle_eip712_struct_def(const uint8_t *const apdu_buf) {
             case P2_DEF_FIELD:
                 ret = set_struct_field(apdu_buf[OFFSET_LC], &apdu_buf[OFFSET_CDATA]);
                 break;
+            case P2_DEF_BATCH:
+                ret = struct_def_batch(&apdu_buf[OFFSET_CDATA], apdu_buf[OFFSET_LC]);
+                break;
             default:
                 PRINTF("Unknown P2 0x%x for APDU 0x%x\n",
                        apdu_buf[OFFSET_P2],
@@ -93,10 +184,56 @@ bool handle_eip712_struct_def(const uint8_t *const apdu_buf) {
                 ret = false;
         }
     }
+    mem_set_tag(tag);
     handle_eip712_return_code(ret);
     return ret;
 }
 
+/**
+ * Process the field values of a batched struct implementation command
+ *
+ * Stops whenever a value has to be displayed, and resumes once the user has moved on
+ * from it.
+ *
+ * @return whether the processing was successful or not
+ */
+static bool struct_impl_batch_process(void) {
+    const uint8_t *value;
+    uint16_t value_length;
+    // also resumed from the UI, outside of the APDU handler
+    e_mem_tag tag = mem_set_tag(MEM_TAG_EIP712_PATH);
+
+    impl_batch.running = true;
+    while (impl_batch.length > 0) {
+        if (impl_batch.length < sizeof(value_length)) {
+            apdu_response_code = APDU_RESPONSE_INVALID_DATA;
+            break;
+        }
+        value_length = (impl_batch.data[0] << 8) | impl_batch.data[1];  // network byte order
+        if ((sizeof(value_length) + value_length) > impl_batch.length) {
+            apdu_response_code = APDU_RESPONSE_INVALID_DATA;
+            break;
+        }
+        value = impl_batch.data;
+        impl_batch.data += sizeof(value_length) + value_length;
+        impl_batch.length -= sizeof(value_length) + value_length;
+        impl_batch.field_done = false;
+        if (!field_hash(value, sizeof(value_length) + value_length, false)) {
+            break;
+        }
+        if (!impl_batch.field_done) {
+            // being displayed or last value replied to
+            impl_batch.running = false;
+            mem_set_tag(tag);
+            return true;
+        }
+    }
+    impl_batch.running = false;
+    impl_batch.length = 0;
+    mem_set_tag(tag);
+    return false;
+}
+
 /**
  * Process the EIP712 struct implementation command
  *
@@ -106,10 +243,12 @@ bool handle_eip712_struct_def(const uint8_t *const apdu_buf) {
 bool handle_eip712_struct_impl(const uint8_t *const apdu_buf) {
     bool ret = false;
     bool reply_apdu = true;
+    e_mem_tag tag;
 
     if (eip712_context == NULL) {
         apdu_response_code = APDU_RESPONSE_CONDITION_NOT_SATISFIED;
     } else {
+        tag = mem_set_tag(MEM_TAG_EIP712_PATH);
         switch (apdu_buf[OFFSET_P2]) {
             case P2_IMPL_NAME:
                 // set root type
@@ -129,6 +268,22 @@ bool handle_eip712_struct_impl(const uint8_t *const apdu_buf) {
                     reply_apdu = false;
                 }
                 break;
+            case P2_IMPL_FIELDS:
+                if (apdu_buf[OFFSET_LC] == 0) {
+                    apdu_response_code = APDU_RESPONSE_INVALID_DATA;
+                    break;
+                }
+                // the values have to be complete, not the continuation of a partial one
+                if (!field_hash_is_idle()) {
+                    apdu_response_code = APDU_RESPONSE_CONDITION_NOT_SATISFIED;
+                    break;
+                }
+                impl_batch.data = &apdu_buf[OFFSET_CDATA];
+                impl_batch.length = apdu_buf[OFFSET_LC];
+                if ((ret = struct_impl_batch_process())) {
+                    reply_apdu = false;
+                }
+                break;
             case P2_IMPL_ARRAY:
                 ret = path_new_array_depth(&apdu_buf[OFFSET_CDATA], apdu_buf[OFFSET_LC]);
                 break;
@@ -138,6 +293,7 @@ bool handle_eip712_struct_impl(const uint8_t *const apdu_buf) {
                        apdu_buf[OFFSET_INS]);
                 apdu_response_code = APDU_RESPONSE_INVALID_P1_P2;
         }
+        mem_set_tag(tag);
     }
     if (reply_apdu) {
         handle_eip712_return_code(ret);
@@ -154,6 +310,7 @@ bool handle_eip712_struct_impl(const uint8_t *const apdu_buf) {
 bool handle_eip712_filtering(const uint8_t *const apdu_buf) {
     bool ret = true;
     bool reply_apdu = true;
+    e_mem_tag tag;
 
     if (eip712_context == NULL) {
         apdu_response_code = APDU_RESPONSE_CONDITION_NOT_SATISFIED;
@@ -164,6 +321,7 @@ bool handle_eip712_filtering(const uint8_t *const apdu_buf) {
         handle_eip712_return_code(true);
         return true;
     }
+    tag = mem_set_tag(MEM_TAG_EIP712_FILTERING);
     switch (apdu_buf[OFFSET_P2]) {
         case P2_FILT_ACTIVATE:
             if (!N_storage.verbose_eip712) {
@@ -173,7 +331,10 @@ bool handle_eip712_filtering(const uint8_t *const apdu_buf) {
             forget_known_assets();
             break;
         case P2_FILT_MESSAGE_INFO:
-            ret = filtering_message_info(&apdu_buf[OFFSET_CDATA], apdu_buf[OFFSET_LC]);
+        case P2_FILT_MESSAGE_MANIFEST:
+            ret = filtering_message_info(&apdu_buf[OFFSET_CDATA],
+                                         apdu_buf[OFFSET_LC],
+                                         apdu_buf[OFFSET_P2] == P2_FILT_MESSAGE_MANIFEST);
             if (ret) {
                 reply_apdu = false;
             }
@@ -195,6 +356,7 @@ bool handle_eip712_filtering(const uint8_t *const apdu_buf) {
             apdu_response_code = APDU_RESPONSE_INVALID_P1_P2;
             ret = false;
     }
+    mem_set_tag(tag);
     if (reply_apdu) {
         handle_eip712_return_code(ret);
     }
@@ -10,6 +10,7 @@
 #include "field_hash.h"
 #include "ui_logic.h"
 #include "typed_data.h"
+#include "type_hash.h"
 #include "apdu_constants.h"  // APDU response codes
 #include "shared_context.h"  // reset_app_context
 #include "common_ui.h"       // ui_idle
@@ -55,6 +56,7 @@ bool eip712_context_init(void) {
     // Since they are optional, they might not be provided by the JSON data
     explicit_bzero(eip712_context->contract_addr, sizeof(eip712_context->contract_addr));
     eip712_context->chain_id = 0;
+    eip712_context->filters_manifest = false;
 
     struct_state = NOT_INITIALIZED;
 
@@ -66,6 +68,7 @@ bool eip712_context_init(void) {
  */
 void eip712_context_deinit(void) {
     typed_data_deinit();
+    type_hash_deinit();
     path_deinit();
     field_hash_deinit();
     ui_712_deinit();
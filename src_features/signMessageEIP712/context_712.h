@@ -10,6 +10,9 @@ typedef struct {
     uint8_t contract_addr[ADDRESS_LENGTH];
     uint64_t chain_id;
     uint8_t schema_hash[224 / 8];
+    // root of the filters manifest, if one was given with the message info
+    uint8_t filters_root[32];
+    bool filters_manifest;
 } s_eip712_context;
 
 extern s_eip712_context *eip712_context;
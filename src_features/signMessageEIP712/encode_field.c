@@ -3,52 +3,53 @@
 #include <stdlib.h>
 #include <string.h>
 #include "encode_field.h"
-#include "mem.h"
+#include "path.h"
 #include "shared_context.h"
 #include "apdu_constants.h"  // APDU response codes
 
 typedef enum { MSB, LSB } e_padding_type;
 
+static const uint8_t zero_padding[EIP_712_ENCODED_FIELD_LENGTH] = {0x00};
+static const uint8_t ones_padding[EIP_712_ENCODED_FIELD_LENGTH] = {
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+};
+
 /**
- * Encode a field value to 32 bytes (padded)
+ * Encode a field value to 32 bytes (padded) straight into the hash of the current depth
  *
  * @param[in] value field value to encode
  * @param[in] length field length before encoding
  * @param[in] ptype padding direction (LSB vs MSB)
- * @param[in] pval value used for padding
- * @return encoded field value
+ * @param[in] pval value used for padding (0x00 or 0xFF)
+ * @return whether the encoding was successful or not
  */
-static void *field_encode(const uint8_t *const value,
-                          uint8_t length,
-                          e_padding_type ptype,
-                          uint8_t pval) {
-    uint8_t *padded_value;
-    uint8_t start_idx;
+static bool field_encode(const uint8_t *const value,
+                         uint8_t length,
+                         e_padding_type ptype,
+                         uint8_t pval) {
+    const uint8_t *padding = (pval == 0x00) ? zero_padding : ones_padding;
 
     if (length > EIP_712_ENCODED_FIELD_LENGTH)  // sanity check
     {
         apdu_response_code = APDU_RESPONSE_INVALID_DATA;
-        return NULL;
+        return false;
     }
-    if ((padded_value = mem_alloc(EIP_712_ENCODED_FIELD_LENGTH)) != NULL) {
-        switch (ptype) {
-            case MSB:
-                memset(padded_value, pval, EIP_712_ENCODED_FIELD_LENGTH - length);
-                start_idx = EIP_712_ENCODED_FIELD_LENGTH - length;
-                break;
-            case LSB:
-                explicit_bzero(padded_value + length, EIP_712_ENCODED_FIELD_LENGTH - length);
-                start_idx = 0;
-                break;
-            default:
-                apdu_response_code = APDU_RESPONSE_CONDITION_NOT_SATISFIED;
-                return NULL;  // should not be here
-        }
-        memcpy(&padded_value[start_idx], value, length);
-    } else {
-        apdu_response_code = APDU_RESPONSE_INSUFFICIENT_MEMORY;
+    switch (ptype) {
+        case MSB:
+            path_hash_nbytes(padding, EIP_712_ENCODED_FIELD_LENGTH - length);
+            path_hash_nbytes(value, length);
+            break;
+        case LSB:
+            path_hash_nbytes(value, length);
+            path_hash_nbytes(padding, EIP_712_ENCODED_FIELD_LENGTH - length);
+            break;
+        default:
+            apdu_response_code = APDU_RESPONSE_CONDITION_NOT_SATISFIED;
+            return false;  // should not be here
     }
-    return padded_value;
+    return true;
 }
 
 /**
@@ -56,9 +57,9 @@ static void *field_encode(const uint8_t *const value,
  *
  * @param[in] value pointer to the "packed" integer received
  * @param[in] length its byte-length
- * @return the encoded value
+ * @return whether the encoding was successful or not
  */
-void *encode_uint(const uint8_t *const value, uint8_t length) {
+bool encode_uint(const uint8_t *const value, uint8_t length) {
     // no length check here since it will be checked by field_encode
     return field_encode(value, length, MSB, 0x00);
 }
@@ -69,14 +70,14 @@ void *encode_uint(const uint8_t *const value, uint8_t length) {
  * @param[in] value pointer to the "packed" integer received
  * @param[in] length its byte-length
  * @param[in] typesize the type size in bytes
- * @return the encoded value
+ * @return whether the encoding was successful or not
  */
-void *encode_int(const uint8_t *const value, uint8_t length, uint8_t typesize) {
+bool encode_int(const uint8_t *const value, uint8_t length, uint8_t typesize) {
     uint8_t padding_value;
 
     if (length < 1) {
         apdu_response_code = APDU_RESPONSE_INVALID_DATA;
-        return NULL;
+        return false;
     }
 
     if ((length == typesize) && (value[0] & (1 << 7)))  // negative number
@@ -94,9 +95,9 @@ void *encode_int(const uint8_t *const value, uint8_t length, uint8_t typesize) {
  *
  * @param[in] value pointer to the "packed" bytes array
  * @param[in] length its byte-length
- * @return the encoded value
+ * @return whether the encoding was successful or not
  */
-void *encode_bytes(const uint8_t *const value, uint8_t length) {
+bool encode_bytes(const uint8_t *const value, uint8_t length) {
     // no length check here since it will be checked by field_encode
     return field_encode(value, length, LSB, 0x00);
 }
@@ -106,13 +107,13 @@ void *encode_bytes(const uint8_t *const value, uint8_t length) {
  *
  * @param[in] value pointer to the boolean received
  * @param[in] length its byte-length
- * @return the encoded value
+ * @return whether the encoding was successful or not
  */
-void *encode_boolean(const bool *const value, uint8_t length) {
+bool encode_boolean(const bool *const value, uint8_t length) {
     if (length != 1)  // sanity check
     {
         apdu_response_code = APDU_RESPONSE_INVALID_DATA;
-        return NULL;
+        return false;
     }
     return encode_uint((uint8_t *) value, length);
 }
@@ -122,13 +123,13 @@ void *encode_boolean(const bool *const value, uint8_t length) {
  *
  * @param[in] value pointer to the address received
  * @param[in] length its byte-length
- * @return the encoded value
+ * @return whether the encoding was successful or not
  */
-void *encode_address(const uint8_t *const value, uint8_t length) {
+bool encode_address(const uint8_t *const value, uint8_t length) {
     if (length != ADDRESS_LENGTH)  // sanity check
     {
         apdu_response_code = APDU_RESPONSE_INVALID_DATA;
-        return NULL;
+        return false;
     }
     return encode_uint(value, length);
 }
@@ -8,11 +8,11 @@
 
 #define EIP_712_ENCODED_FIELD_LENGTH 32
 
-void *encode_uint(const uint8_t *const value, uint8_t length);
-void *encode_int(const uint8_t *const value, uint8_t length, uint8_t typesize);
-void *encode_boolean(const bool *const value, uint8_t length);
-void *encode_address(const uint8_t *const value, uint8_t length);
-void *encode_bytes(const uint8_t *const value, uint8_t length);
+bool encode_uint(const uint8_t *const value, uint8_t length);
+bool encode_int(const uint8_t *const value, uint8_t length, uint8_t typesize);
+bool encode_boolean(const bool *const value, uint8_t length);
+bool encode_address(const uint8_t *const value, uint8_t length);
+bool encode_bytes(const uint8_t *const value, uint8_t length);
 
 #endif  // HAVE_EIP712_FULL_SUPPORT
 
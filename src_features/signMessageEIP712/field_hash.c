@@ -40,6 +40,15 @@ void field_hash_deinit(void) {
     fh = NULL;
 }
 
+/**
+ * Check whether no field value is partially received
+ *
+ * @return whether it is the case
+ */
+bool field_hash_is_idle(void) {
+    return (fh != NULL) && (fh->state == FHS_IDLE);
+}
+
 /**
  * Special handling of the first chunk received from a field value
  *
@@ -70,93 +79,65 @@ end:
 /**
  * Finalize static field hash
  *
- * Encode the field data depending on its type
+ * Encode the field data depending on its type into the hash of the current depth
  *
  * @param[in] field_ptr pointer to the struct field definition
  * @param[in] data the field value
  * @param[in] data_length the value length
- * @return pointer to the encoded value
+ * @return whether the encoding was successful or not
  */
-static const uint8_t *field_hash_finalize_static(const void *const field_ptr,
-                                                 const uint8_t *const data,
-                                                 uint8_t data_length) {
-    uint8_t *value = NULL;
+static bool field_hash_finalize_static(const void *const field_ptr,
+                                       const uint8_t *const data,
+                                       uint8_t data_length) {
+    bool ret = false;
     e_type field_type;
 
     field_type = struct_field_type(field_ptr);
     switch (field_type) {
         case TYPE_SOL_INT:
-            value = encode_int(data, data_length, get_struct_field_typesize(field_ptr));
+            ret = encode_int(data, data_length, get_struct_field_typesize(field_ptr));
             break;
         case TYPE_SOL_UINT:
-            value = encode_uint(data, data_length);
+            ret = encode_uint(data, data_length);
             break;
         case TYPE_SOL_BYTES_FIX:
-            value = encode_bytes(data, data_length);
+            ret = encode_bytes(data, data_length);
             break;
         case TYPE_SOL_ADDRESS:
-            value = encode_address(data, data_length);
+            ret = encode_address(data, data_length);
             break;
         case TYPE_SOL_BOOL:
-            value = encode_boolean((bool *) data, data_length);
+            ret = encode_boolean((bool *) data, data_length);
             break;
         case TYPE_CUSTOM:
         default:
             apdu_response_code = APDU_RESPONSE_INVALID_DATA;
             PRINTF("Unknown solidity type!\n");
     }
-    return value;
+    return ret;
 }
 
 /**
  * Finalize dynamic field hash
  *
- * Allocate and hash the data
+ * Feed the hash of the data into the hash of the current depth
  *
- * @return pointer to the hash, \ref NULL if it failed
+ * @return whether it was successful or not
  */
-static uint8_t *field_hash_finalize_dynamic(void) {
-    uint8_t *value;
+static bool field_hash_finalize_dynamic(void) {
+    uint8_t hash[KECCAK256_HASH_BYTESIZE];
     cx_err_t error = CX_INTERNAL_ERROR;
 
-    if ((value = mem_alloc(KECCAK256_HASH_BYTESIZE)) == NULL) {
-        apdu_response_code = APDU_RESPONSE_INSUFFICIENT_MEMORY;
-        return NULL;
-    }
-    // copy hash into memory
     CX_CHECK(cx_hash_no_throw((cx_hash_t *) &global_sha3,
                               CX_LAST,
                               NULL,
                               0,
-                              value,
-                              KECCAK256_HASH_BYTESIZE));
-    return value;
+                              hash,
+                              sizeof(hash)));
+    path_hash_nbytes(hash, sizeof(hash));
+    return true;
 end:
-    return NULL;
-}
-
-/**
- * Feed the newly created field hash into the parent struct's progressive hash
- *
- * @param[in] field_type the struct field's type
- * @param[in] hash the field hash
- */
-static void field_hash_feed_parent(e_type field_type, const uint8_t *const hash) {
-    uint8_t len;
-
-    if (IS_DYN(field_type)) {
-        len = KECCAK256_HASH_BYTESIZE;
-    } else {
-        len = EIP_712_ENCODED_FIELD_LENGTH;
-    }
-
-    // last thing in mem is the hash of the previous field
-    // and just before it is the current hash context
-    cx_sha3_t *hash_ctx = (cx_sha3_t *) (hash - sizeof(cx_sha3_t));
-    // continue the progressive hash on it
-    hash_nbytes(hash, len, (cx_hash_t *) hash_ctx);
-    // deallocate it
-    mem_dealloc(len);
+    return false;
 }
 
 /**
@@ -201,22 +182,19 @@ static bool field_hash_domain_special_fields(const void *const field_ptr,
 static bool field_hash_finalize(const void *const field_ptr,
                                 const uint8_t *const data,
                                 uint8_t data_length) {
-    const uint8_t *value = NULL;
     e_type field_type;
 
     field_type = struct_field_type(field_ptr);
     if (!IS_DYN(field_type)) {
-        if ((value = field_hash_finalize_static(field_ptr, data, data_length)) == NULL) {
+        if (!field_hash_finalize_static(field_ptr, data, data_length)) {
             return false;
         }
     } else {
-        if ((value = field_hash_finalize_dynamic()) == NULL) {
+        if (!field_hash_finalize_dynamic()) {
             return false;
         }
     }
 
-    field_hash_feed_parent(field_type, value);
-
     if (path_get_root_type() == ROOT_DOMAIN) {
         if (field_hash_domain_special_fields(field_ptr, data, data_length) == false) {
             return false;
@@ -17,6 +17,7 @@ typedef struct {
 
 bool field_hash_init(void);
 void field_hash_deinit(void);
+bool field_hash_is_idle(void);
 bool field_hash(const uint8_t *data, uint8_t data_length, bool partial);
 
 #endif  // HAVE_EIP712_FULL_SUPPORT
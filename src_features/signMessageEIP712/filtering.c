@@ -1,5 +1,6 @@
 #ifdef HAVE_EIP712_FULL_SUPPORT
 
+#include <string.h>
 #include "filtering.h"
 #include "hash_bytes.h"
 #include "ethUstream.h"      // INT256_LENGTH
@@ -13,6 +14,7 @@
 #include "ui_logic.h"
 
 #define FILT_MAGIC_MESSAGE_INFO      183
+#define FILT_MAGIC_MESSAGE_MANIFEST  184
 #define FILT_MAGIC_AMOUNT_JOIN_TOKEN 11
 #define FILT_MAGIC_AMOUNT_JOIN_VALUE 22
 #define FILT_MAGIC_DATETIME          33
@@ -20,38 +22,11 @@
 
 #define TOKEN_IDX_ADDR_IN_DOMAIN 0xff
 
-/**
- * Reconstruct the field path and hash it
- *
- * @param[in] hash_ctx the hashing context
- */
-static void hash_filtering_path(cx_hash_t *hash_ctx) {
-    const void *field_ptr;
-    const char *key;
-    uint8_t key_len;
-
-    for (uint8_t i = 0; i < path_get_depth_count(); ++i) {
-        if (i > 0) {
-            hash_byte('.', hash_ctx);
-        }
-        if ((field_ptr = path_get_nth_field(i + 1)) != NULL) {
-            if ((key = get_struct_field_keyname(field_ptr, &key_len)) != NULL) {
-                // field name
-                hash_nbytes((uint8_t *) key, key_len, hash_ctx);
-
-                // array levels
-                if (struct_field_is_array(field_ptr)) {
-                    uint8_t lvl_count;
-
-                    get_struct_field_array_lvls_array(field_ptr, &lvl_count);
-                    for (int j = 0; j < lvl_count; ++j) {
-                        hash_nbytes((uint8_t *) ".[]", 3, hash_ctx);
-                    }
-                }
-            }
-        }
-    }
-}
+// enough for 128 filters while fitting in an APDU with the filter display name
+#define FILT_MANIFEST_MAX_DEPTH 7
+
+// prefix of the manifest tree nodes, so that they can't be mistaken for leaves
+#define FILT_MANIFEST_NODE_PREFIX 0x01
 
 /**
  * Begin the hashing for signature verification
@@ -85,26 +60,22 @@ static bool sig_verif_start(cx_sha256_t *hash_ctx, uint8_t magic) {
 }
 
 /**
- * End the hashing & do the signature verification
+ * Verify the signature of a hash with the CAL key
  *
- * @param[in] hash_ctx hashing context
+ * @param[in] hash the hash
  * @param[in] sig signature
  * @param[in] sig_length signature length
  * @return whether the signature verification worked or not
  */
-static bool sig_verif_end(cx_sha256_t *hash_ctx, const uint8_t *sig, uint8_t sig_length) {
-    uint8_t hash[INT256_LENGTH];
+static bool sig_verif_hash(const uint8_t *hash, const uint8_t *sig, uint8_t sig_length) {
     cx_ecfp_public_key_t verifying_key;
     cx_err_t error = CX_INTERNAL_ERROR;
 
-    // Finalize hash
-    CX_CHECK(cx_hash_no_throw((cx_hash_t *) hash_ctx, CX_LAST, NULL, 0, hash, INT256_LENGTH));
-
     CX_CHECK(cx_ecfp_init_public_key_no_throw(CX_CURVE_256K1,
                                               LEDGER_SIGNATURE_PUBLIC_KEY,
                                               sizeof(LEDGER_SIGNATURE_PUBLIC_KEY),
                                               &verifying_key));
-    if (!cx_ecdsa_verify_no_throw(&verifying_key, hash, sizeof(hash), sig, sig_length)) {
+    if (!cx_ecdsa_verify_no_throw(&verifying_key, hash, INT256_LENGTH, sig, sig_length)) {
 #ifndef HAVE_BYPASS_SIGNATURES
         PRINTF("Invalid EIP-712 filtering signature\n");
         apdu_response_code = APDU_RESPONSE_INVALID_DATA;
@@ -116,6 +87,74 @@ end:
     return false;
 }
 
+/**
+ * Check that a filter is part of the manifest received with the message info
+ *
+ * The tree nodes are the hash of the node prefix followed by their two children, the smallest
+ * one first, so that the proof does not need to give the position of each sibling.
+ *
+ * @param[in] leaf hash of the filter
+ * @param[in] proof sibling hashes from the leaf to the root
+ * @param[in] proof_length proof length
+ * @return whether the filter is part of the manifest
+ */
+static bool manifest_verif_hash(const uint8_t *leaf, const uint8_t *proof, uint8_t proof_length) {
+    uint8_t node[INT256_LENGTH];
+    const uint8_t *sibling;
+    cx_sha256_t hash_ctx;
+    bool node_first;
+
+    if (((proof_length % INT256_LENGTH) != 0) ||
+        ((proof_length / INT256_LENGTH) > FILT_MANIFEST_MAX_DEPTH)) {
+        apdu_response_code = APDU_RESPONSE_INVALID_DATA;
+        return false;
+    }
+    memcpy(node, leaf, sizeof(node));
+    for (uint8_t off = 0; off < proof_length; off += INT256_LENGTH) {
+        sibling = &proof[off];
+        node_first = memcmp(node, sibling, sizeof(node)) < 0;
+        cx_sha256_init(&hash_ctx);
+        hash_byte(FILT_MANIFEST_NODE_PREFIX, (cx_hash_t *) &hash_ctx);
+        hash_nbytes(node_first ? node : sibling, sizeof(node), (cx_hash_t *) &hash_ctx);
+        hash_nbytes(node_first ? sibling : node, sizeof(node), (cx_hash_t *) &hash_ctx);
+        if (cx_hash_no_throw((cx_hash_t *) &hash_ctx, CX_LAST, NULL, 0, node, sizeof(node)) !=
+            CX_OK) {
+            return false;
+        }
+    }
+    if (memcmp(node, eip712_context->filters_root, sizeof(node)) != 0) {
+        PRINTF("EIP-712 filter not part of the manifest\n");
+        apdu_response_code = APDU_RESPONSE_INVALID_DATA;
+        return false;
+    }
+    return true;
+}
+
+/**
+ * End the hashing & do the signature verification
+ *
+ * If a manifest has been received, the signature is instead a proof that the filter is part
+ * of it.
+ *
+ * @param[in] hash_ctx hashing context
+ * @param[in] sig signature or manifest proof
+ * @param[in] sig_length signature or manifest proof length
+ * @return whether the signature verification worked or not
+ */
+static bool sig_verif_end(cx_sha256_t *hash_ctx, const uint8_t *sig, uint8_t sig_length) {
+    uint8_t hash[INT256_LENGTH];
+
+    // Finalize hash
+    if (cx_hash_no_throw((cx_hash_t *) hash_ctx, CX_LAST, NULL, 0, hash, INT256_LENGTH) !=
+        CX_OK) {
+        return false;
+    }
+    if (eip712_context->filters_manifest) {
+        return manifest_verif_hash(hash, sig, sig_length);
+    }
+    return sig_verif_hash(hash, sig, sig_length);
+}
+
 /**
  * Check if the given token index is valid
  *
@@ -127,7 +166,7 @@ static bool check_token_index(uint8_t idx) {
         PRINTF("Error: token index out of range (%u)\n", idx);
         return false;
     }
-    if (!tmpCtx.transactionContext.assetSet[idx]) {
+    if (!asset_info_is_set(idx)) {
         PRINTF("Error: token not set (%u)\n", idx);
         return false;
     }
@@ -157,19 +196,25 @@ static bool check_typename(const char *expected) {
 /**
  * Command to give the message information
  *
+ * With a manifest, the signature also covers the root of a hash tree of all the filters of
+ * the message, which then only need to come with a proof instead of their own signature.
+ *
  * @param[in] payload the payload to parse
  * @param[in] length the payload length
+ * @param[in] manifest whether the payload contains a manifest root
  * @return whether it was successful or not
  */
-bool filtering_message_info(const uint8_t *payload, uint8_t length) {
+bool filtering_message_info(const uint8_t *payload, uint8_t length, bool manifest) {
     uint8_t name_len;
     const char *name;
     uint8_t filters_count;
+    const uint8_t *root = NULL;
     uint8_t sig_len;
     const uint8_t *sig;
     uint8_t offset = 0;
+    uint8_t hash[INT256_LENGTH];
 
-    if (path_get_root_type() != ROOT_DOMAIN) {
+    if ((path_get_root_type() != ROOT_DOMAIN) || eip712_context->filters_manifest) {
         apdu_response_code = APDU_RESPONSE_CONDITION_NOT_SATISFIED;
         return false;
     }
@@ -188,6 +233,13 @@ bool filtering_message_info(const uint8_t *payload, uint8_t length) {
         return false;
     }
     filters_count = payload[offset++];
+    if (manifest) {
+        if ((offset + sizeof(eip712_context->filters_root)) > length) {
+            return false;
+        }
+        root = &payload[offset];
+        offset += sizeof(eip712_context->filters_root);
+    }
     if ((offset + sizeof(sig_len)) > length) {
         return false;
     }
@@ -199,16 +251,26 @@ bool filtering_message_info(const uint8_t *payload, uint8_t length) {
 
     // Verification
     cx_sha256_t hash_ctx;
-    if (!sig_verif_start(&hash_ctx, FILT_MAGIC_MESSAGE_INFO)) {
+    if (!sig_verif_start(&hash_ctx,
+                         manifest ? FILT_MAGIC_MESSAGE_MANIFEST : FILT_MAGIC_MESSAGE_INFO)) {
         return false;
     }
     hash_byte(filters_count, (cx_hash_t *) &hash_ctx);
     hash_nbytes((uint8_t *) name, sizeof(char) * name_len, (cx_hash_t *) &hash_ctx);
-    if (!sig_verif_end(&hash_ctx, sig, sig_len)) {
+    if (manifest) {
+        hash_nbytes(root, sizeof(eip712_context->filters_root), (cx_hash_t *) &hash_ctx);
+    }
+    if ((cx_hash_no_throw((cx_hash_t *) &hash_ctx, CX_LAST, NULL, 0, hash, sizeof(hash)) !=
+         CX_OK) ||
+        !sig_verif_hash(hash, sig, sig_len)) {
         return false;
     }
 
     // Handling
+    if (manifest) {
+        memcpy(eip712_context->filters_root, root, sizeof(eip712_context->filters_root));
+        eip712_context->filters_manifest = true;
+    }
     ui_712_set_filters_count(filters_count);
     if (!N_storage.verbose_eip712) {
         ui_712_set_title("Contract", 8);
@@ -261,7 +323,7 @@ bool filtering_date_time(const uint8_t *payload, uint8_t length) {
     if (!sig_verif_start(&hash_ctx, FILT_MAGIC_DATETIME)) {
         return false;
     }
-    hash_filtering_path((cx_hash_t *) &hash_ctx);
+    path_hash_str((cx_hash_t *) &hash_ctx);
     hash_nbytes((uint8_t *) name, sizeof(char) * name_len, (cx_hash_t *) &hash_ctx);
     if (!sig_verif_end(&hash_ctx, sig, sig_len)) {
         return false;
@@ -315,7 +377,7 @@ bool filtering_amount_join_token(const uint8_t *payload, uint8_t length) {
     if (!sig_verif_start(&hash_ctx, FILT_MAGIC_AMOUNT_JOIN_TOKEN)) {
         return false;
     }
-    hash_filtering_path((cx_hash_t *) &hash_ctx);
+    path_hash_str((cx_hash_t *) &hash_ctx);
     hash_byte(token_idx, (cx_hash_t *) &hash_ctx);
     if (!sig_verif_end(&hash_ctx, sig, sig_len)) {
         return false;
@@ -381,7 +443,7 @@ bool filtering_amount_join_value(const uint8_t *payload, uint8_t length) {
     if (!sig_verif_start(&hash_ctx, FILT_MAGIC_AMOUNT_JOIN_VALUE)) {
         return false;
     }
-    hash_filtering_path((cx_hash_t *) &hash_ctx);
+    path_hash_str((cx_hash_t *) &hash_ctx);
     hash_nbytes((uint8_t *) name, sizeof(char) * name_len, (cx_hash_t *) &hash_ctx);
     hash_byte(token_idx, (cx_hash_t *) &hash_ctx);
     if (!sig_verif_end(&hash_ctx, sig, sig_len)) {
@@ -391,7 +453,8 @@ bool filtering_amount_join_value(const uint8_t *payload, uint8_t length) {
     // Handling
     if (token_idx == TOKEN_IDX_ADDR_IN_DOMAIN) {
         // Permit (ERC-2612)
-        int resolved_idx = get_asset_index_by_addr(eip712_context->contract_addr);
+        int resolved_idx = get_asset_index_by_addr(eip712_context->contract_addr,
+                                                   eip712_context->chain_id);
 
         if (resolved_idx == -1) {
             PRINTF("ERROR: Could not find asset info for verifyingContract address!\n");
@@ -453,7 +516,7 @@ bool filtering_raw_field(const uint8_t *payload, uint8_t length) {
     if (!sig_verif_start(&hash_ctx, FILT_MAGIC_RAW_FIELD)) {
         return false;
     }
-    hash_filtering_path((cx_hash_t *) &hash_ctx);
+    path_hash_str((cx_hash_t *) &hash_ctx);
     hash_nbytes((uint8_t *) name, sizeof(char) * name_len, (cx_hash_t *) &hash_ctx);
     if (!sig_verif_end(&hash_ctx, sig, sig_len)) {
         return false;
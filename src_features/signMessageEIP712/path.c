@@ -12,9 +12,16 @@
 #include "ui_logic.h"
 #include "apdu_constants.h"  // APDU response codes
 #include "typed_data.h"
+#include "hash_bytes.h"
 
 static s_path *path_struct = NULL;
 
+// hashing context of the deepest depth, the other ones are kept in memory in compact form
+static cx_sha3_t *last_hash_ctx = NULL;
+static uint8_t hash_depth_count;
+
+static void path_next_field(void);
+
 /**
  * Get the field pointer to by the first N depths of the path.
  *
@@ -23,44 +30,25 @@ static s_path *path_struct = NULL;
  * @return the field which the first Nth depths points to
  */
 static const void *get_nth_field(uint8_t *const fields_count_ptr, uint8_t n) {
-    const void *struct_ptr = NULL;
-    const void *field_ptr = NULL;
-    const char *typename;
-    uint8_t length;
-    uint8_t fields_count;
+    const s_path_cursor *cursor;
 
     if (path_struct == NULL) {
         return NULL;
     }
 
-    struct_ptr = path_struct->root_struct;
-
-    if (n > path_struct->depth_count)  // sanity check
+    if ((n == 0) || (n > path_struct->depth_count))  // sanity check
     {
         return NULL;
     }
-    for (uint8_t depth = 0; depth < n; ++depth) {
-        field_ptr = get_struct_fields_array(struct_ptr, &fields_count);
-
-        if (fields_count_ptr != NULL) {
-            *fields_count_ptr = fields_count;
-        }
-        // check if the index at this depth makes sense
-        if (path_struct->depths[depth] > fields_count) {
-            return NULL;
-        }
-
-        for (uint8_t index = 0; index < path_struct->depths[depth]; ++index) {
-            field_ptr = get_next_struct_field(field_ptr);
-        }
-        if (struct_field_type(field_ptr) == TYPE_CUSTOM) {
-            typename = get_struct_field_typename(field_ptr, &length);
-            if ((struct_ptr = get_structn(typename, length)) == NULL) {
-                return NULL;
-            }
-        }
+    cursor = &path_struct->cursors[n - 1];
+    if (fields_count_ptr != NULL) {
+        *fields_count_ptr = cursor->fields_count;
+    }
+    // check if the index at this depth makes sense
+    if (path_struct->depths[n - 1] > cursor->fields_count) {
+        return NULL;
     }
-    return field_ptr;
+    return cursor->field_ptr;
 }
 
 /**
@@ -90,15 +78,12 @@ const void *path_get_nth_field(uint8_t n) {
  * @return pointer to the matching field, \ref NULL otherwise
  */
 const void *path_get_nth_field_to_last(uint8_t n) {
-    const char *typename;
-    uint8_t typename_len;
     const void *field_ptr;
     const void *struct_ptr = NULL;
 
     field_ptr = get_nth_field(NULL, path_struct->depth_count - n);
     if (field_ptr != NULL) {
-        typename = get_struct_field_typename(field_ptr, &typename_len);
-        struct_ptr = get_structn(typename, typename_len);
+        struct_ptr = get_struct_field_custom_struct(field_ptr);
     }
     return struct_ptr;
 }
@@ -112,30 +97,184 @@ const void *path_get_field(void) {
     return get_field(NULL);
 }
 
+/**
+ * Forget the path string from a given depth, when the field at that depth changes
+ *
+ * @param[in] depth_idx index of the first depth to forget
+ */
+static void path_str_invalidate(uint8_t depth_idx) {
+    if (path_struct->str_depth > depth_idx) {
+        path_struct->str_depth = depth_idx;
+    }
+}
+
+/**
+ * Get the dotted path of the current field (e.g. "details.recipients.[].wallet")
+ *
+ * Only the depths that changed since the last call are rebuilt, starting from the end of the
+ * last unchanged one.
+ *
+ * @param[out] length length of the path string
+ * @return pointer to the path string, \ref NULL if it does not fit in the buffer
+ */
+const char *path_get_str(uint8_t *length) {
+    const void *field_ptr;
+    const char *key;
+    uint8_t key_len;
+    uint8_t lvl_count = 0;
+    uint16_t off;
+
+    if (path_struct == NULL) {
+        return NULL;
+    }
+    off = (path_struct->str_depth > 0) ? path_struct->str_ends[path_struct->str_depth - 1] : 0;
+    for (uint8_t i = path_struct->str_depth; i < path_struct->depth_count; ++i) {
+        if (i > 0) {
+            if ((off + 1) > sizeof(path_struct->str)) {
+                return NULL;
+            }
+            path_struct->str[off++] = '.';
+        }
+        if (((field_ptr = path_get_nth_field(i + 1)) != NULL) &&
+            ((key = get_struct_field_keyname(field_ptr, &key_len)) != NULL)) {
+            if (struct_field_is_array(field_ptr)) {
+                get_struct_field_array_lvls_array(field_ptr, &lvl_count);
+            } else {
+                lvl_count = 0;
+            }
+            if ((off + key_len + (lvl_count * 3)) > sizeof(path_struct->str)) {
+                return NULL;
+            }
+            memcpy(&path_struct->str[off], key, key_len);
+            off += key_len;
+            for (uint8_t j = 0; j < lvl_count; ++j) {
+                memcpy(&path_struct->str[off], ".[]", 3);
+                off += 3;
+            }
+        }
+        path_struct->str_ends[i] = off;
+        path_struct->str_depth = i + 1;
+    }
+    *length = off;
+    return path_struct->str;
+}
+
+/**
+ * Hash the dotted path of the current field
+ *
+ * Uses the path string when it is available, and only reconstructs it from the struct fields
+ * if it is too long to be kept.
+ *
+ * @param[in] hash_ctx the hashing context
+ */
+void path_hash_str(cx_hash_t *hash_ctx) {
+    const void *field_ptr;
+    const char *key;
+    uint8_t key_len;
+    const char *path_str;
+    uint8_t path_len;
+
+    if ((path_str = path_get_str(&path_len)) != NULL) {
+        hash_nbytes((uint8_t *) path_str, path_len, hash_ctx);
+        return;
+    }
+    for (uint8_t i = 0; i < path_get_depth_count(); ++i) {
+        if (i > 0) {
+            hash_byte('.', hash_ctx);
+        }
+        if ((field_ptr = path_get_nth_field(i + 1)) != NULL) {
+            if ((key = get_struct_field_keyname(field_ptr, &key_len)) != NULL) {
+                // field name
+                hash_nbytes((uint8_t *) key, key_len, hash_ctx);
+
+                // array levels
+                if (struct_field_is_array(field_ptr)) {
+                    uint8_t lvl_count;
+
+                    get_struct_field_array_lvls_array(field_ptr, &lvl_count);
+                    for (int j = 0; j < lvl_count; ++j) {
+                        hash_nbytes((uint8_t *) ".[]", 3, hash_ctx);
+                    }
+                }
+            }
+        }
+    }
+}
+
 /**
  * Go down (add) a depth level.
  *
  * @return whether the push was successful
  */
 static bool path_depth_list_push(void) {
+    const void *struct_ptr;
+    s_path_cursor *cursor;
+
     if (path_struct == NULL) {
         return false;
     }
     if (path_struct->depth_count == MAX_PATH_DEPTH) {
         return false;
     }
+    if (path_struct->depth_count == 0) {
+        struct_ptr = path_struct->root_struct;
+    } else {
+        // the new depth goes into the struct of the field currently pointed to
+        cursor = &path_struct->cursors[path_struct->depth_count - 1];
+        if ((struct_ptr = get_struct_field_custom_struct(cursor->field_ptr)) == NULL) {
+            return false;
+        }
+    }
+    cursor = &path_struct->cursors[path_struct->depth_count];
+    if ((cursor->field_ptr = get_struct_fields_array(struct_ptr, &cursor->fields_count)) == NULL) {
+        return false;
+    }
     path_struct->depths[path_struct->depth_count] = 0;
     path_struct->depth_count += 1;
     return true;
 }
 
 /**
- * Get the last hashing context (corresponding to the current path depth)
+ * Store the hashing context of the deepest depth in memory
+ *
+ * Only what is needed to resume it is kept : the Keccak state & the partial block that has not
+ * been absorbed yet, followed by its length so that it can be found from the top of the memory.
+ *
+ * @return whether the memory allocation was successful
+ */
+static bool save_hash_depth(void) {
+    uint8_t *state;
+    uint8_t blen = last_hash_ctx->blen;
+
+    if ((state = mem_alloc(sizeof(last_hash_ctx->acc) + blen + sizeof(blen))) == NULL) {
+        apdu_response_code = APDU_RESPONSE_INSUFFICIENT_MEMORY;
+        return false;
+    }
+    memcpy(state, last_hash_ctx->acc, sizeof(last_hash_ctx->acc));
+    memcpy(state + sizeof(last_hash_ctx->acc), last_hash_ctx->block, blen);
+    state[sizeof(last_hash_ctx->acc) + blen] = blen;
+    return true;
+}
+
+/**
+ * Resume the hashing context stored at the top of the memory
  *
- * @return pointer to the hashing context
+ * @return whether the hashing context could be initialized
  */
-static cx_sha3_t *get_last_hash_ctx(void) {
-    return ((cx_sha3_t *) mem_alloc(0)) - 1;
+static bool restore_hash_depth(void) {
+    const uint8_t *top = mem_alloc(0);
+    uint8_t blen = *(top - 1);
+    const uint8_t *state = top - sizeof(blen) - blen - sizeof(last_hash_ctx->acc);
+    cx_err_t error = CX_INTERNAL_ERROR;
+
+    CX_CHECK(cx_keccak_init_no_throw(last_hash_ctx, 256));
+    memcpy(last_hash_ctx->acc, state, sizeof(last_hash_ctx->acc));
+    memcpy(last_hash_ctx->block, state + sizeof(last_hash_ctx->acc), blen);
+    last_hash_ctx->blen = blen;
+    mem_dealloc(sizeof(last_hash_ctx->acc) + blen + sizeof(blen));
+    return true;
+end:
+    return false;
 }
 
 /**
@@ -145,16 +284,21 @@ static cx_sha3_t *get_last_hash_ctx(void) {
  * @return whether there was anything hashed at this depth
  */
 static bool finalize_hash_depth(uint8_t *hash) {
-    const cx_sha3_t *hash_ctx;
     size_t hashed_bytes;
     cx_err_t error = CX_INTERNAL_ERROR;
 
-    hash_ctx = get_last_hash_ctx();
-    hashed_bytes = hash_ctx->blen;
+    hashed_bytes = last_hash_ctx->blen;
     // finalize hash
-    CX_CHECK(
-        cx_hash_no_throw((cx_hash_t *) hash_ctx, CX_LAST, NULL, 0, hash, KECCAK256_HASH_BYTESIZE));
-    mem_dealloc(sizeof(*hash_ctx));  // remove hash context
+    CX_CHECK(cx_hash_no_throw((cx_hash_t *) last_hash_ctx,
+                              CX_LAST,
+                              NULL,
+                              0,
+                              hash,
+                              KECCAK256_HASH_BYTESIZE));
+    hash_depth_count -= 1;
+    if ((hash_depth_count > 0) && !restore_hash_depth()) {
+        return false;
+    }
     return hashed_bytes > 0;
 end:
     return false;
@@ -166,35 +310,73 @@ end:
  * @param[in] hash pointer to given hash
  */
 static void feed_last_hash_depth(const uint8_t *const hash) {
-    const cx_sha3_t *hash_ctx;
-
-    hash_ctx = get_last_hash_ctx();
     // continue progressive hash with the array hash
-    CX_ASSERT(cx_hash_no_throw((cx_hash_t *) hash_ctx, 0, hash, KECCAK256_HASH_BYTESIZE, NULL, 0));
+    CX_ASSERT(cx_hash_no_throw((cx_hash_t *) last_hash_ctx,
+                               0,
+                               hash,
+                               KECCAK256_HASH_BYTESIZE,
+                               NULL,
+                               0));
+}
+
+/**
+ * Continue the hashing context of the current depth with the given data
+ *
+ * @param[in] data the data
+ * @param[in] length the data length
+ */
+void path_hash_nbytes(const uint8_t *data, uint8_t length) {
+    hash_nbytes(data, length, (cx_hash_t *) last_hash_ctx);
 }
 
 /**
- * Create a new hashing context depth in memory
+ * Create a new hashing context depth
+ *
+ * The previous deepest one gets stored in memory.
  *
- * @param[in] init if the hashing context should be initialized
  * @return whether the memory allocation of the hashing context was successful
  */
-static bool push_new_hash_depth(bool init) {
-    cx_sha3_t *hash_ctx;
+static bool push_new_hash_depth(void) {
     cx_err_t error = CX_INTERNAL_ERROR;
 
-    // allocate new hash context
-    if ((hash_ctx = MEM_ALLOC_AND_ALIGN_TYPE(*hash_ctx)) == NULL) {
+    if ((hash_depth_count > 0) && !save_hash_depth()) {
         return false;
     }
-    if (init) {
-        CX_CHECK(cx_keccak_init_no_throw(hash_ctx, 256));
-    }
+    CX_CHECK(cx_keccak_init_no_throw(last_hash_ctx, 256));
+    hash_depth_count += 1;
     return true;
 end:
     return false;
 }
 
+/**
+ * Create a new hashing context depth below the given number of deepest ones
+ *
+ * The suspended depths that go above it get moved up in memory to make room for it.
+ *
+ * @param[in] depths_above number of depths to keep above it, the deepest one included
+ * @return whether the memory allocation of the hashing context was successful
+ */
+static bool insert_new_hash_depth(uint8_t depths_above) {
+    const uint8_t *top = mem_alloc(0);
+    uint8_t *state = (uint8_t *) top;
+    uint8_t blen;
+
+    for (uint8_t idx = 1; idx < depths_above; ++idx) {
+        blen = *(state - 1);
+        state -= sizeof(last_hash_ctx->acc) + blen + sizeof(blen);
+    }
+    if (mem_alloc(sizeof(last_hash_ctx->acc) + sizeof(blen)) == NULL) {
+        apdu_response_code = APDU_RESPONSE_INSUFFICIENT_MEMORY;
+        return false;
+    }
+    memmove(state + sizeof(last_hash_ctx->acc) + sizeof(blen), state, top - state);
+    // blank Keccak state without any partial block
+    explicit_bzero(state, sizeof(last_hash_ctx->acc) + sizeof(blen));
+    hash_depth_count += 1;
+    return true;
+}
+
 /**
  * Go up (remove) a depth level.
  *
@@ -211,6 +393,7 @@ static bool path_depth_list_pop(void) {
         return false;
     }
     path_struct->depth_count -= 1;
+    path_str_invalidate(path_struct->depth_count);
 
     to_feed = finalize_hash_depth(hash);
     if (path_struct->depth_count > 0) {
@@ -317,14 +500,14 @@ static bool path_update(bool skip_if_array, bool stop_at_array) {
             }
         }
         typename = get_struct_field_typename(field_ptr, &typename_len);
-        if ((struct_ptr = get_structn(typename, typename_len)) == NULL) {
+        if ((struct_ptr = get_struct_field_custom_struct(field_ptr)) == NULL) {
             return false;
         }
         if ((field_ptr = get_struct_fields_array(struct_ptr, &fields_count)) == NULL) {
             return false;
         }
 
-        if (push_new_hash_depth(true) == false) {
+        if (push_new_hash_depth() == false) {
             return false;
         }
 
@@ -362,6 +545,11 @@ bool path_set_root(const char *const struct_name, uint8_t name_length) {
         return false;
     }
 
+    // the struct definitions are complete once the first root is set
+    if ((struct_state != DEFINED) && (!typed_data_build_index() || !type_hash_init())) {
+        return false;
+    }
+
     path_struct->root_struct = get_structn(struct_name, name_length);
 
     if (path_struct->root_struct == NULL) {
@@ -374,7 +562,7 @@ bool path_set_root(const char *const struct_name, uint8_t name_length) {
         return false;
     }
 
-    if (push_new_hash_depth(true) == false) {
+    if (push_new_hash_depth() == false) {
         return false;
     }
     if (type_hash(struct_name, name_length, hash) == false) {
@@ -385,6 +573,7 @@ bool path_set_root(const char *const struct_name, uint8_t name_length) {
 
     // init depth, at 0 : empty path
     path_struct->depth_count = 0;
+    path_struct->str_depth = 0;
     path_depth_list_push();
 
     // init array levels at 0
@@ -457,6 +646,7 @@ bool path_new_array_depth(const uint8_t *const data, uint8_t length) {
     bool is_custom;
     uint8_t array_size;
     uint8_t array_depth_count_bak;
+    bool end_of_array;
     cx_err_t error = CX_INTERNAL_ERROR;
 
     if (path_struct == NULL) {
@@ -498,24 +688,27 @@ bool path_new_array_depth(const uint8_t *const data, uint8_t length) {
         return false;
     }
     is_custom = struct_field_type(field_ptr) == TYPE_CUSTOM;
-    if (push_new_hash_depth(!is_custom) == false) {
-        return false;
-    }
     if (is_custom) {
-        cx_sha3_t *hash_ctx = get_last_hash_ctx();
-        cx_sha3_t *old_ctx = hash_ctx - 1;
-
-        if (array_size > 0) {
-            memcpy(hash_ctx, old_ctx, sizeof(*old_ctx));
-        } else {
-            CX_CHECK(cx_keccak_init_no_throw(hash_ctx, 256));
+        // the hashes of the first struct of the array, and of the structs it starts with, have
+        // already been started
+        if (insert_new_hash_depth(path_struct->depth_count - (pidx + 1)) == false) {
+            return false;
+        }
+        if (array_size == 0) {
+            CX_CHECK(cx_keccak_init_no_throw(last_hash_ctx, 256));
+        }
+    } else {
+        if (push_new_hash_depth() == false) {
+            return false;
         }
-        CX_CHECK(cx_keccak_init_no_throw(old_ctx, 256));
     }
     if (array_size == 0) {
         do {
-            path_advance(false);
-        } while (path_struct->array_depth_count > array_depth_count_bak);
+            path_next_field();
+            end_of_array = path_struct->array_depth_count <= array_depth_count_bak;
+            // the field that follows the array is entered like after any other value
+            path_update(end_of_array, end_of_array);
+        } while (!end_of_array);
     }
 
     return true;
@@ -532,6 +725,7 @@ static bool path_advance_in_struct(void) {
     bool end_reached = true;
     uint8_t *depth = &path_struct->depths[path_struct->depth_count - 1];
     uint8_t fields_count;
+    s_path_cursor *cursor;
 
     if (path_struct == NULL) {
         return false;
@@ -541,6 +735,9 @@ static bool path_advance_in_struct(void) {
     }
     if (path_struct->depth_count > 0) {
         *depth += 1;
+        cursor = &path_struct->cursors[path_struct->depth_count - 1];
+        cursor->field_ptr = get_next_struct_field(cursor->field_ptr);
+        path_str_invalidate(path_struct->depth_count - 1);
         ui_712_notify_filter_change();
         end_reached = (*depth == fields_count);
     }
@@ -581,11 +778,9 @@ static bool path_advance_in_array(void) {
 }
 
 /**
- * Updates the path to point to the next field in order (DFS).
- *
- * @return whether the advancement was successful or not
+ * Move the path to the next field in order (DFS), without going down into it if it is a struct.
  */
-bool path_advance(bool array_check) {
+static void path_next_field(void) {
     bool end_reached;
 
     do {
@@ -595,6 +790,15 @@ bool path_advance(bool array_check) {
             end_reached = false;
         }
     } while (end_reached);
+}
+
+/**
+ * Updates the path to point to the next field in order (DFS).
+ *
+ * @return whether the advancement was successful or not
+ */
+bool path_advance(bool array_check) {
+    path_next_field();
     return path_update(array_check, array_check);
 }
 
@@ -641,10 +845,14 @@ uint8_t path_get_depth_count(void) {
  */
 bool path_init(void) {
     if (path_struct == NULL) {
-        if ((path_struct = MEM_ALLOC_AND_ALIGN_TYPE(*path_struct)) == NULL) {
+        if (((path_struct = MEM_ALLOC_AND_ALIGN_TYPE(*path_struct)) == NULL) ||
+            ((last_hash_ctx = MEM_ALLOC_AND_ALIGN_TYPE(*last_hash_ctx)) == NULL)) {
             apdu_response_code = APDU_RESPONSE_INSUFFICIENT_MEMORY;
+            path_struct = NULL;
         } else {
             path_struct->depth_count = 0;
+            path_struct->str_depth = 0;
+            hash_depth_count = 0;
         }
     }
     return path_struct != NULL;
@@ -655,6 +863,7 @@ bool path_init(void) {
  */
 void path_deinit(void) {
     path_struct = NULL;
+    last_hash_ctx = NULL;
 }
 
 #endif  // HAVE_EIP712_FULL_SUPPORT
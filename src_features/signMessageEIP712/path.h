@@ -5,9 +5,11 @@
 
 #include <stdint.h>
 #include <stdbool.h>
+#include "cx.h"
 
 #define MAX_PATH_DEPTH  16
 #define MAX_ARRAY_DEPTH 8
+#define MAX_PATH_STR    128
 
 typedef struct {
     uint8_t path_index;
@@ -17,13 +19,26 @@ typedef struct {
 
 typedef enum { ROOT_DOMAIN, ROOT_MESSAGE } e_root_type;
 
+typedef struct {
+    const void *field_ptr;
+    uint8_t fields_count;
+} s_path_cursor;
+
 typedef struct {
     uint8_t depth_count;
     uint8_t depths[MAX_PATH_DEPTH];
+    // field pointed to by each depth, kept in sync with depths
+    s_path_cursor cursors[MAX_PATH_DEPTH];
     uint8_t array_depth_count;
     s_array_depth array_depths[MAX_ARRAY_DEPTH];
     const void *root_struct;
     e_root_type root_type;
+    // dotted path of the current field, used by the filters
+    char str[MAX_PATH_STR];
+    // end of the path string at each depth
+    uint8_t str_ends[MAX_PATH_DEPTH];
+    // number of depths for which the path string is up to date
+    uint8_t str_depth;
 } s_path;
 
 bool path_set_root(const char *const struct_name, uint8_t length);
@@ -37,6 +52,9 @@ const void *path_get_root(void);
 const void *path_get_nth_field(uint8_t n);
 const void *path_get_nth_field_to_last(uint8_t n);
 uint8_t path_get_depth_count(void);
+const char *path_get_str(uint8_t *length);
+void path_hash_str(cx_hash_t *hash_ctx);
+void path_hash_nbytes(const uint8_t *data, uint8_t length);
 
 #endif  // HAVE_EIP712_FULL_SUPPORT
 
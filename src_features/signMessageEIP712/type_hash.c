@@ -12,6 +12,14 @@
 #include "apdu_constants.h"  // APDU response codes
 #include "typed_data.h"
 
+typedef struct {
+    uint32_t sort_key;
+    uint8_t ordinal;
+} s_type_dep;
+
+// type hash of every struct, by ordinal
+static uint8_t *type_hashes = NULL;
+
 /**
  * Encode & hash the given structure field
  *
@@ -74,122 +82,174 @@ static bool encode_and_hash_type(const void *const struct_ptr) {
 }
 
 /**
- * Sort the given structs based by alphabetical order
+ * Get the bit of a given index in a bitmap
+ *
+ * @param[in] bitmap the bitmap
+ * @param[in] idx the index
+ * @return whether the bit is set
+ */
+static inline bool bitmap_get(const uint8_t *bitmap, uint8_t idx) {
+    return (bitmap[idx / 8] & (1 << (idx % 8))) != 0;
+}
+
+/**
+ * Set the bit of a given index in a bitmap
+ *
+ * @param[in,out] bitmap the bitmap
+ * @param[in] idx the index
+ */
+static inline void bitmap_set(uint8_t *bitmap, uint8_t idx) {
+    bitmap[idx / 8] |= (1 << (idx % 8));
+}
+
+/**
+ * Compute the sort key of a struct, its first four name characters
+ *
+ * @param[in] struct_ptr pointer to the struct
+ * @return sort key
+ */
+static uint32_t struct_sort_key(const void *const struct_ptr) {
+    const char *name;
+    uint8_t name_length;
+    uint32_t key = 0;
+
+    name = get_struct_name(struct_ptr, &name_length);
+    for (uint8_t idx = 0; idx < sizeof(key); ++idx) {
+        key <<= 8;
+        if (idx < name_length) {
+            key |= (uint8_t) name[idx];
+        }
+    }
+    return key;
+}
+
+/**
+ * Compare two dependencies based on their names' alphabetical order
  *
- * @param[in] deps_count count of how many struct dependencies pointers
- * @param[in,out] deps pointer to the first dependency pointer
+ * @param[in] dep1 first dependency
+ * @param[in] dep2 second dependency
+ * @return negative, zero or positive value like strcmp
  */
-static void sort_dependencies(uint8_t deps_count, const void **deps) {
-    bool changed;
-    const void *tmp_ptr;
+static int compare_dependencies(const s_type_dep *dep1, const s_type_dep *dep2) {
     const char *name1, *name2;
     uint8_t namelen1, namelen2;
     int str_cmp_result;
 
-    do {
-        changed = false;
-        for (size_t idx = 0; (idx + 1) < deps_count; ++idx) {
-            name1 = get_struct_name(*(deps + idx), &namelen1);
-            name2 = get_struct_name(*(deps + idx + 1), &namelen2);
+    if (dep1->sort_key != dep2->sort_key) {
+        return (dep1->sort_key < dep2->sort_key) ? -1 : 1;
+    }
+    name1 = get_struct_name(get_struct_from_ordinal(dep1->ordinal), &namelen1);
+    name2 = get_struct_name(get_struct_from_ordinal(dep2->ordinal), &namelen2);
+    str_cmp_result = strncmp(name1, name2, MIN(namelen1, namelen2));
+    if (str_cmp_result == 0) {
+        str_cmp_result = namelen1 - namelen2;
+    }
+    return str_cmp_result;
+}
 
-            str_cmp_result = strncmp(name1, name2, MIN(namelen1, namelen2));
-            if ((str_cmp_result > 0) || ((str_cmp_result == 0) && (namelen1 > namelen2))) {
-                tmp_ptr = *(deps + idx);
-                *(deps + idx) = *(deps + idx + 1);
-                *(deps + idx + 1) = tmp_ptr;
+/**
+ * Sort the given structs based by alphabetical order
+ *
+ * @param[in] deps_count count of how many struct dependencies
+ * @param[in,out] deps pointer to the first dependency
+ */
+static void sort_dependencies(uint8_t deps_count, s_type_dep *deps) {
+    s_type_dep tmp;
+    uint8_t pos;
 
-                changed = true;
-            }
+    for (uint8_t idx = 1; idx < deps_count; ++idx) {
+        tmp = deps[idx];
+        for (pos = idx; (pos > 0) && (compare_dependencies(&deps[pos - 1], &tmp) > 0); --pos) {
+            deps[pos] = deps[pos - 1];
         }
-    } while (changed);
+        deps[pos] = tmp;
+    }
 }
 
 /**
  * Find all the dependencies from a given structure
  *
- * @param[out] deps_count count of how many struct dependency pointers
- * @param[in] first_dep pointer to the first dependency pointer
- * @param[in] struct_ptr pointer to the struct we are getting the dependencies of
+ * Each newly found dependency is appended to the array and then scanned itself,
+ * the array serving as the worklist.
+ *
+ * @param[in] ordinal ordinal of the struct we are getting the dependencies of
+ * @param[out] deps_count count of how many struct dependencies
  * @return pointer to the first found dependency, \ref NULL otherwise
  */
-static const void **get_struct_dependencies(uint8_t *const deps_count,
-                                            const void **first_dep,
-                                            const void *const struct_ptr) {
+static s_type_dep *get_struct_dependencies(uint8_t ordinal, uint8_t *const deps_count) {
+    uint8_t visited[(UINT8_MAX + 1) / 8] = {0};
+    uint8_t structs_count;
+    const void *struct_ptr;
     uint8_t fields_count;
     const void *field_ptr;
-    const char *arg_structname;
-    uint8_t arg_structname_length;
     const void *arg_struct_ptr;
-    size_t dep_idx;
-    const void **new_dep;
+    uint8_t arg_ordinal;
+    uint8_t next_dep = 0;
+    s_type_dep *deps;
 
-    field_ptr = get_struct_fields_array(struct_ptr, &fields_count);
-    for (uint8_t idx = 0; idx < fields_count; ++idx) {
-        if (struct_field_type(field_ptr) == TYPE_CUSTOM) {
-            // get struct name
-            arg_structname = get_struct_field_typename(field_ptr, &arg_structname_length);
-            // from its name, get the pointer to its definition
-            arg_struct_ptr = get_structn(arg_structname, arg_structname_length);
-
-            // check if it is not already present in the dependencies array
-            for (dep_idx = 0; dep_idx < *deps_count; ++dep_idx) {
-                // it's a match!
-                if (*(first_dep + dep_idx) == arg_struct_ptr) {
-                    break;
-                }
-            }
-            // if it's not present in the array, add it and recurse into it
-            if (dep_idx == *deps_count) {
-                *deps_count += 1;
-                if ((new_dep = MEM_ALLOC_AND_ALIGN_TYPE(void *)) == NULL) {
-                    apdu_response_code = APDU_RESPONSE_INSUFFICIENT_MEMORY;
+    get_structs_array(&structs_count);
+    if ((deps = mem_alloc_and_align(sizeof(*deps) * structs_count, __alignof__(*deps))) == NULL) {
+        apdu_response_code = APDU_RESPONSE_INSUFFICIENT_MEMORY;
+        return NULL;
+    }
+    *deps_count = 0;
+    bitmap_set(visited, ordinal);
+    struct_ptr = get_struct_from_ordinal(ordinal);
+    while (struct_ptr != NULL) {
+        field_ptr = get_struct_fields_array(struct_ptr, &fields_count);
+        for (uint8_t idx = 0; idx < fields_count; ++idx) {
+            if (struct_field_type(field_ptr) == TYPE_CUSTOM) {
+                // get its definition
+                if (!get_struct_field_custom_ordinal(field_ptr, &arg_ordinal) ||
+                    ((arg_struct_ptr = get_struct_from_ordinal(arg_ordinal)) == NULL)) {
                     return NULL;
                 }
-                if (*deps_count == 1) {
-                    first_dep = new_dep;
+                // if it's not already a dependency, add it
+                if (!bitmap_get(visited, arg_ordinal)) {
+                    bitmap_set(visited, arg_ordinal);
+                    deps[*deps_count].ordinal = arg_ordinal;
+                    deps[*deps_count].sort_key = struct_sort_key(arg_struct_ptr);
+                    *deps_count += 1;
                 }
-                *new_dep = arg_struct_ptr;
-                // TODO: Move away from recursive calls
-                get_struct_dependencies(deps_count, first_dep, arg_struct_ptr);
             }
+            field_ptr = get_next_struct_field(field_ptr);
+        }
+        struct_ptr = NULL;
+        if (next_dep < *deps_count) {
+            struct_ptr = get_struct_from_ordinal(deps[next_dep++].ordinal);
         }
-        field_ptr = get_next_struct_field(field_ptr);
     }
-    return first_dep;
+    return deps;
 }
 
 /**
  * Encode the structure's type and hash it
  *
- * @param[in] struct_name name of the given struct
- * @param[in] struct_name_length length of the name of the given struct
+ * @param[in] ordinal ordinal of the given struct
  * @param[out] hash_buf buffer containing the resulting type_hash
  * @return whether the type_hash was successful or not
  */
-bool type_hash(const char *const struct_name, const uint8_t struct_name_length, uint8_t *hash_buf) {
-    const void *const struct_ptr = get_structn(struct_name, struct_name_length);
+static bool compute_type_hash(uint8_t ordinal, uint8_t *hash_buf) {
     uint8_t deps_count = 0;
-    const void **deps;
-    void *mem_loc_bak = mem_alloc(0);
+    s_type_dep *deps;
+    size_t mem_loc_bak = mem_mark();
     cx_err_t error = CX_INTERNAL_ERROR;
 
     CX_CHECK(cx_keccak_init_no_throw(&global_sha3, 256));
-    deps = get_struct_dependencies(&deps_count, NULL, struct_ptr);
-    if ((deps_count > 0) && (deps == NULL)) {
+    if ((deps = get_struct_dependencies(ordinal, &deps_count)) == NULL) {
         return false;
     }
     sort_dependencies(deps_count, deps);
-    if (encode_and_hash_type(struct_ptr) == false) {
+    if (encode_and_hash_type(get_struct_from_ordinal(ordinal)) == false) {
         return false;
     }
     // loop over each struct and generate string
     for (int idx = 0; idx < deps_count; ++idx) {
-        if (encode_and_hash_type(*deps) == false) {
+        if (encode_and_hash_type(get_struct_from_ordinal(deps[idx].ordinal)) == false) {
             return false;
         }
-        deps += 1;
     }
-    mem_dealloc(mem_alloc(0) - mem_loc_bak);
+    mem_release_to(mem_loc_bak);
 
     // copy hash into memory
     CX_CHECK(cx_hash_no_throw((cx_hash_t *) &global_sha3,
@@ -203,4 +263,57 @@ end:
     return false;
 }
 
+/**
+ * Compute the type hashes of all the structs, once they are all defined
+ *
+ * @return whether it was successful or not
+ */
+bool type_hash_init(void) {
+    uint8_t structs_count;
+
+    if (type_hashes == NULL) {
+        get_structs_array(&structs_count);
+        if ((type_hashes = mem_alloc(KECCAK256_HASH_BYTESIZE * structs_count)) == NULL) {
+            apdu_response_code = APDU_RESPONSE_INSUFFICIENT_MEMORY;
+            return false;
+        }
+        for (uint8_t ordinal = 0; ordinal < structs_count; ++ordinal) {
+            if (!compute_type_hash(ordinal, &type_hashes[ordinal * KECCAK256_HASH_BYTESIZE])) {
+                type_hashes = NULL;
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+/**
+ * De-initialize the type hashes
+ */
+void type_hash_deinit(void) {
+    type_hashes = NULL;
+}
+
+/**
+ * Get the type hash of a given structure
+ *
+ * @param[in] struct_name name of the given struct
+ * @param[in] struct_name_length length of the name of the given struct
+ * @param[out] hash_buf buffer containing the resulting type_hash
+ * @return whether the type_hash was successful or not
+ */
+bool type_hash(const char *const struct_name, const uint8_t struct_name_length, uint8_t *hash_buf) {
+    const void *const struct_ptr = get_structn(struct_name, struct_name_length);
+    uint8_t ordinal;
+
+    if ((struct_ptr == NULL) || !get_struct_ordinal(struct_ptr, &ordinal)) {
+        return false;
+    }
+    if (type_hashes == NULL) {
+        return compute_type_hash(ordinal, hash_buf);
+    }
+    memcpy(hash_buf, &type_hashes[ordinal * KECCAK256_HASH_BYTESIZE], KECCAK256_HASH_BYTESIZE);
+    return true;
+}
+
 #endif  // HAVE_EIP712_FULL_SUPPORT
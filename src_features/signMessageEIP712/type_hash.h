@@ -6,6 +6,8 @@
 #include <stdint.h>
 #include <stdbool.h>
 
+bool type_hash_init(void);
+void type_hash_deinit(void);
 bool type_hash(const char *const struct_name, const uint8_t struct_name_length, uint8_t *hash_buf);
 
 #endif  // HAVE_EIP712_FULL_SUPPORT
@@ -30,6 +30,9 @@ bool typed_data_init(void) {
 
         // create len(types)
         *(typed_data->structs_array) = 0;
+
+        typed_data->structs_ptrs = NULL;
+        typed_data->structs_index = NULL;
     }
     return true;
 }
@@ -61,8 +64,12 @@ static const uint8_t *field_skip_typename(const uint8_t *field_ptr, const uint8_
     uint8_t size = 0;
 
     if (struct_field_type(field_ptr) == TYPE_CUSTOM) {
-        get_string_in_mem(ptr, &size);
-        ptr += (sizeof(size) + size);
+        if (*field_ptr & TYPENAME_ORDINAL_MASK) {
+            ptr += sizeof(uint8_t);
+        } else {
+            get_string_in_mem(ptr, &size);
+            ptr += (sizeof(size) + size);
+        }
     }
     return ptr;
 }
@@ -200,6 +207,28 @@ uint8_t get_struct_field_typesize(const uint8_t *const field_ptr) {
     return *field_skip_typedesc(field_ptr, NULL);
 }
 
+/**
+ * Get the struct ordinal stored in a custom-type struct field
+ *
+ * @param[in] field_ptr struct field pointer
+ * @param[out] ordinal struct ordinal
+ * @return whether it has one, \ref false if the field only holds the type name
+ */
+static bool get_stored_custom_ordinal(const uint8_t *field_ptr, uint8_t *const ordinal) {
+    const uint8_t *ptr = field_skip_typedesc(field_ptr, NULL);
+
+    if (*field_ptr & TYPENAME_ORDINAL_MASK) {
+        *ordinal = *ptr;
+        return true;
+    }
+    if (*field_ptr & TYPENAME_RESOLVED_MASK) {
+        // right after the name length
+        *ordinal = *(ptr + sizeof(uint8_t));
+        return true;
+    }
+    return false;
+}
+
 /**
  * Get custom type name from a struct field
  *
@@ -208,13 +237,16 @@ uint8_t get_struct_field_typesize(const uint8_t *const field_ptr) {
  * @return type name pointer
  */
 const char *get_struct_field_custom_typename(const uint8_t *field_ptr, uint8_t *const length) {
-    const uint8_t *ptr;
+    uint8_t ordinal;
 
     if (field_ptr == NULL) {
         return NULL;
     }
-    ptr = field_skip_typedesc(field_ptr, NULL);
-    return get_string_in_mem(ptr, length);
+    if (get_stored_custom_ordinal(field_ptr, &ordinal)) {
+        // the name is only kept in the struct definition
+        return get_struct_name(get_struct_from_ordinal(ordinal), length);
+    }
+    return get_string_in_mem(field_skip_typedesc(field_ptr, NULL), length);
 }
 
 /**
@@ -410,22 +442,35 @@ const uint8_t *get_structs_array(uint8_t *const length) {
 }
 
 /**
- * Find struct with a given name
+ * Compute the hash of a struct name used to index it (32-bit FNV-1a)
+ *
+ * @param[in] name struct name
+ * @param[in] length name length
+ * @return name hash
+ */
+static uint32_t struct_name_hash(const char *const name, uint8_t length) {
+    uint32_t hash = 0x811c9dc5;
+
+    for (uint8_t idx = 0; idx < length; ++idx) {
+        hash ^= (uint8_t) name[idx];
+        hash *= 0x01000193;
+    }
+    return hash;
+}
+
+/**
+ * Find struct with a given name by going through all the structs
  *
  * @param[in] name struct name
  * @param[in] length name length
  * @return pointer to struct
  */
-const uint8_t *get_structn(const char *const name, const uint8_t length) {
+static const uint8_t *get_structn_linear(const char *const name, const uint8_t length) {
     uint8_t structs_count = 0;
     const uint8_t *struct_ptr;
     const char *struct_name;
     uint8_t name_length;
 
-    if (name == NULL) {
-        apdu_response_code = APDU_RESPONSE_CONDITION_NOT_SATISFIED;
-        return NULL;
-    }
     struct_ptr = get_structs_array(&structs_count);
     while (structs_count-- > 0) {
         struct_name = get_struct_name(struct_ptr, &name_length);
@@ -434,10 +479,360 @@ const uint8_t *get_structn(const char *const name, const uint8_t length) {
         }
         struct_ptr = get_next_struct(struct_ptr);
     }
-    apdu_response_code = APDU_RESPONSE_CONDITION_NOT_SATISFIED;
     return NULL;
 }
 
+/**
+ * Find the ordinal of the struct with a given name by going through all the structs
+ *
+ * Safe to use while the last struct is still being defined, since it never goes past its name.
+ *
+ * @param[in] name struct name
+ * @param[in] length name length
+ * @param[out] ordinal struct ordinal
+ * @return whether it was found
+ */
+static bool get_structn_ordinal_linear(const char *const name,
+                                       const uint8_t length,
+                                       uint8_t *const ordinal) {
+    uint8_t structs_count = 0;
+    const uint8_t *struct_ptr;
+    const char *struct_name;
+    uint8_t name_length;
+
+    struct_ptr = get_structs_array(&structs_count);
+    for (uint8_t idx = 0; idx < structs_count; ++idx) {
+        struct_name = get_struct_name(struct_ptr, &name_length);
+        if ((length == name_length) && (memcmp(name, struct_name, length) == 0)) {
+            *ordinal = idx;
+            return true;
+        }
+        if ((idx + 1) < structs_count) {
+            struct_ptr = get_next_struct(struct_ptr);
+        }
+    }
+    return false;
+}
+
+/**
+ * Find struct with a given name from the structs index
+ *
+ * @param[in] name struct name
+ * @param[in] length name length
+ * @return pointer to struct
+ */
+static const uint8_t *get_structn_indexed(const char *const name, const uint8_t length) {
+    const s_struct_index_entry *entries = typed_data->structs_index;
+    uint32_t hash = struct_name_hash(name, length);
+    const char *struct_name;
+    uint8_t name_length;
+    uint8_t structs_count;
+    uint8_t low = 0;
+    uint8_t high;
+    uint8_t mid;
+
+    get_structs_array(&structs_count);
+    high = structs_count;
+    // lower bound of the hash in the sorted entries
+    while (low < high) {
+        mid = low + ((high - low) / 2);
+        if (entries[mid].name_hash < hash) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+    // go through the entries sharing that hash
+    for (; (low < structs_count) && (entries[low].name_hash == hash); ++low) {
+        struct_name = get_struct_name(entries[low].struct_ptr, &name_length);
+        if ((length == name_length) && (memcmp(name, struct_name, length) == 0)) {
+            return entries[low].struct_ptr;
+        }
+    }
+    return NULL;
+}
+
+/**
+ * Find struct with a given name
+ *
+ * @param[in] name struct name
+ * @param[in] length name length
+ * @return pointer to struct
+ */
+const uint8_t *get_structn(const char *const name, const uint8_t length) {
+    const uint8_t *struct_ptr;
+
+    if ((name == NULL) || (typed_data == NULL)) {
+        apdu_response_code = APDU_RESPONSE_CONDITION_NOT_SATISFIED;
+        return NULL;
+    }
+    if (typed_data->structs_index != NULL) {
+        struct_ptr = get_structn_indexed(name, length);
+    } else {
+        struct_ptr = get_structn_linear(name, length);
+    }
+    if (struct_ptr == NULL) {
+        apdu_response_code = APDU_RESPONSE_CONDITION_NOT_SATISFIED;
+    }
+    return struct_ptr;
+}
+
+/**
+ * Get the struct definition a custom-type struct field refers to
+ *
+ * @param[in] field_ptr given struct field
+ * @return pointer to struct, \ref NULL if not found
+ */
+const uint8_t *get_struct_field_custom_struct(const uint8_t *field_ptr) {
+    const char *typename;
+    uint8_t typename_length;
+    uint8_t ordinal;
+
+    if ((field_ptr == NULL) || (typed_data == NULL)) {
+        apdu_response_code = APDU_RESPONSE_CONDITION_NOT_SATISFIED;
+        return NULL;
+    }
+    if (get_stored_custom_ordinal(field_ptr, &ordinal)) {
+        return get_struct_from_ordinal(ordinal);
+    }
+    // a type name that did not match any struct when the definitions were completed
+    typename = get_string_in_mem(field_skip_typedesc(field_ptr, NULL), &typename_length);
+    return get_structn(typename, typename_length);
+}
+
+/**
+ * Get the ordinal of the struct a custom-type struct field refers to
+ *
+ * @param[in] field_ptr given struct field
+ * @param[out] ordinal struct ordinal
+ * @return whether it was found
+ */
+bool get_struct_field_custom_ordinal(const uint8_t *field_ptr, uint8_t *const ordinal) {
+    const uint8_t *struct_ptr;
+
+    if ((field_ptr == NULL) || (typed_data == NULL)) {
+        apdu_response_code = APDU_RESPONSE_CONDITION_NOT_SATISFIED;
+        return false;
+    }
+    if (get_stored_custom_ordinal(field_ptr, ordinal)) {
+        return true;
+    }
+    if ((struct_ptr = get_struct_field_custom_struct(field_ptr)) == NULL) {
+        return false;
+    }
+    return get_struct_ordinal(struct_ptr, ordinal);
+}
+
+/**
+ * Get the ordinal of a given struct (its position in the definition order)
+ *
+ * @param[in] struct_ptr given struct
+ * @param[out] ordinal struct ordinal
+ * @return whether it was found
+ */
+bool get_struct_ordinal(const uint8_t *struct_ptr, uint8_t *const ordinal) {
+    const uint8_t **ptrs;
+    uint8_t low = 0;
+    uint8_t high;
+    uint8_t mid;
+
+    if ((typed_data == NULL) || (typed_data->structs_ptrs == NULL)) {
+        apdu_response_code = APDU_RESPONSE_CONDITION_NOT_SATISFIED;
+        return false;
+    }
+    // structs are stored in definition order, so the pointers are sorted
+    ptrs = typed_data->structs_ptrs;
+    get_structs_array(&high);
+    while (low < high) {
+        mid = low + ((high - low) / 2);
+        if (ptrs[mid] == struct_ptr) {
+            *ordinal = mid;
+            return true;
+        }
+        if (ptrs[mid] < struct_ptr) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+    apdu_response_code = APDU_RESPONSE_CONDITION_NOT_SATISFIED;
+    return false;
+}
+
+/**
+ * Get a struct from its ordinal
+ *
+ * @param[in] ordinal struct ordinal
+ * @return pointer to struct, \ref NULL if out of bounds
+ */
+const uint8_t *get_struct_from_ordinal(uint8_t ordinal) {
+    const uint8_t *struct_ptr;
+    uint8_t structs_count;
+
+    if (typed_data == NULL) {
+        apdu_response_code = APDU_RESPONSE_CONDITION_NOT_SATISFIED;
+        return NULL;
+    }
+    struct_ptr = get_structs_array(&structs_count);
+    if (ordinal >= structs_count) {
+        apdu_response_code = APDU_RESPONSE_CONDITION_NOT_SATISFIED;
+        return NULL;
+    }
+    if (typed_data->structs_ptrs != NULL) {
+        return typed_data->structs_ptrs[ordinal];
+    }
+    // definitions still being received
+    while (ordinal-- > 0) {
+        struct_ptr = get_next_struct(struct_ptr);
+    }
+    return struct_ptr;
+}
+
+/**
+ * Resolve the type name of the custom-type fields that were defined before their struct
+ *
+ * The struct ordinal is written over the first character of the name, which is then only
+ * needed to know how much to skip. Names that do not match any struct are kept as is, the
+ * error is caught when they get used.
+ */
+static void resolve_custom_typenames(void) {
+    uint8_t structs_count;
+    uint8_t fields_count;
+    const uint8_t *struct_ptr;
+    uint8_t *field_ptr;
+    const char *name;
+    uint8_t name_length;
+    uint8_t ordinal;
+
+    struct_ptr = get_structs_array(&structs_count);
+    while (structs_count-- > 0) {
+        field_ptr = (uint8_t *) get_struct_fields_array(struct_ptr, &fields_count);
+        while (fields_count-- > 0) {
+            if ((struct_field_type(field_ptr) == TYPE_CUSTOM) &&
+                ((*field_ptr & (TYPENAME_ORDINAL_MASK | TYPENAME_RESOLVED_MASK)) == 0)) {
+                name = get_string_in_mem(field_skip_typedesc(field_ptr, NULL), &name_length);
+                if ((name_length > 0) && get_structn_ordinal_linear(name, name_length, &ordinal)) {
+                    *(uint8_t *) name = ordinal;
+                    *field_ptr |= TYPENAME_RESOLVED_MASK;
+                }
+            }
+            field_ptr = (uint8_t *) get_next_struct_field(field_ptr);
+        }
+        struct_ptr = field_ptr;
+    }
+}
+
+/**
+ * Shrink the resolved type names of the custom-type fields down to their struct ordinal
+ *
+ * Everything that follows gets moved down, so this can only be done while the struct
+ * definitions are still at the top of the memory.
+ */
+static void compact_custom_typenames(void) {
+    uint8_t structs_count;
+    uint8_t fields_count;
+    const uint8_t *src;
+    const uint8_t *next;
+    const uint8_t *rest;
+    uint8_t *dst;
+    typedesc_t typedesc;
+    uint8_t ordinal;
+
+    src = get_structs_array(&structs_count);
+    while (structs_count-- > 0) {
+        src = get_next_struct(src);
+    }
+    if (src != mem_alloc(0)) {
+        return;
+    }
+
+    src = get_structs_array(&structs_count);
+    dst = (uint8_t *) src;
+    while (structs_count-- > 0) {
+        // struct name & fields count
+        next = get_struct_fields_array(src, &fields_count);
+        memmove(dst, src, next - src);
+        dst += (next - src);
+        typed_data->current_struct_fields_array = dst - sizeof(fields_count);
+        src = next;
+        while (fields_count-- > 0) {
+            next = get_next_struct_field(src);
+            typedesc = *src;
+            if (typedesc & TYPENAME_RESOLVED_MASK) {
+                get_stored_custom_ordinal(src, &ordinal);
+                // skip the TypeDesc, the name length & the name
+                rest = src + sizeof(typedesc) + sizeof(uint8_t) + src[sizeof(typedesc)];
+                *dst++ = (typedesc & ~TYPENAME_RESOLVED_MASK) | TYPENAME_ORDINAL_MASK;
+                *dst++ = ordinal;
+                memmove(dst, rest, next - rest);
+                dst += (next - rest);
+            } else {
+                memmove(dst, src, next - src);
+                dst += (next - src);
+            }
+            src = next;
+        }
+    }
+    mem_dealloc(src - dst);
+}
+
+/**
+ * Resolve the struct of every custom-type field & build the structs index
+ *
+ * Must be called once all the struct definitions have been received, the index is
+ * allocated right after them and stays in memory until the context is de-initialized.
+ *
+ * @return whether it was successful
+ */
+bool typed_data_build_index(void) {
+    const uint8_t **structs_ptrs;
+    s_struct_index_entry *structs_index;
+    s_struct_index_entry tmp;
+    uint8_t structs_count;
+    const uint8_t *struct_ptr;
+    const char *name;
+    uint8_t name_length;
+    uint8_t idx;
+
+    if (typed_data == NULL) {
+        apdu_response_code = APDU_RESPONSE_CONDITION_NOT_SATISFIED;
+        return false;
+    }
+    if (typed_data->structs_index != NULL) {
+        return true;
+    }
+    // struct pointers are only final after this
+    resolve_custom_typenames();
+    compact_custom_typenames();
+
+    struct_ptr = get_structs_array(&structs_count);
+    if ((structs_ptrs = mem_alloc_and_align(sizeof(*structs_ptrs) * structs_count,
+                                            __alignof__(*structs_ptrs))) == NULL) {
+        apdu_response_code = APDU_RESPONSE_INSUFFICIENT_MEMORY;
+        return false;
+    }
+    if ((structs_index = mem_alloc_and_align(sizeof(*structs_index) * structs_count,
+                                             __alignof__(*structs_index))) == NULL) {
+        apdu_response_code = APDU_RESPONSE_INSUFFICIENT_MEMORY;
+        return false;
+    }
+    for (uint8_t sidx = 0; sidx < structs_count; ++sidx) {
+        structs_ptrs[sidx] = struct_ptr;
+        name = get_struct_name(struct_ptr, &name_length);
+        tmp.name_hash = struct_name_hash(name, name_length);
+        tmp.struct_ptr = struct_ptr;
+        // insertion sort on the hash, keeps the definition order for equal hashes
+        for (idx = sidx; (idx > 0) && (structs_index[idx - 1].name_hash > tmp.name_hash); --idx) {
+            structs_index[idx] = structs_index[idx - 1];
+        }
+        structs_index[idx] = tmp;
+        struct_ptr = get_next_struct(struct_ptr);
+    }
+    typed_data->structs_ptrs = structs_ptrs;
+    typed_data->structs_index = structs_index;
+    return true;
+}
+
 /**
  * Set struct name
  *
@@ -493,9 +888,9 @@ bool set_struct_name(uint8_t length, const uint8_t *const name) {
  * @param[in] data_idx the data index
  * @return pointer to the TypeDesc in memory
  */
-static const typedesc_t *set_struct_field_typedesc(const uint8_t *const data,
-                                                   uint8_t *data_idx,
-                                                   uint8_t length) {
+static typedesc_t *set_struct_field_typedesc(const uint8_t *const data,
+                                             uint8_t *data_idx,
+                                             uint8_t length) {
     typedesc_t *typedesc_ptr;
 
     // copy TypeDesc
@@ -508,22 +903,30 @@ static const typedesc_t *set_struct_field_typedesc(const uint8_t *const data,
         apdu_response_code = APDU_RESPONSE_INSUFFICIENT_MEMORY;
         return NULL;
     }
-    *typedesc_ptr = data[(*data_idx)++];
+    *typedesc_ptr = data[(*data_idx)++] & ~(TYPENAME_ORDINAL_MASK | TYPENAME_RESOLVED_MASK);
     return typedesc_ptr;
 }
 
 /**
  * Set struct field custom typename
  *
+ * Only the ordinal gets stored if the struct is already defined, the name is kept otherwise
+ * until all the definitions have been received.
+ *
+ * @param[in,out] typedesc_ptr the field TypeDesc
  * @param[in] data the field data
  * @param[in] data_idx the data index
  * @return whether it was successful
  */
-static bool set_struct_field_custom_typename(const uint8_t *const data,
+static bool set_struct_field_custom_typename(typedesc_t *const typedesc_ptr,
+                                             const uint8_t *const data,
                                              uint8_t *data_idx,
                                              uint8_t length) {
     uint8_t *typename_len_ptr;
+    uint8_t *ordinal_ptr;
     char *typename;
+    uint8_t typename_len;
+    uint8_t ordinal;
 
     // copy custom struct name length
     if ((*data_idx + sizeof(*typename_len_ptr)) > length)  // check buffer bound
@@ -531,24 +934,34 @@ static bool set_struct_field_custom_typename(const uint8_t *const data,
         apdu_response_code = APDU_RESPONSE_INVALID_DATA;
         return false;
     }
-    if ((typename_len_ptr = mem_alloc(sizeof(uint8_t))) == NULL) {
-        apdu_response_code = APDU_RESPONSE_INSUFFICIENT_MEMORY;
-        return false;
-    }
-    *typename_len_ptr = data[(*data_idx)++];
+    typename_len = data[(*data_idx)++];
 
     // copy name
-    if ((*data_idx + *typename_len_ptr) > length)  // check buffer bound
+    if ((*data_idx + typename_len) > length)  // check buffer bound
     {
         apdu_response_code = APDU_RESPONSE_INVALID_DATA;
         return false;
     }
-    if ((typename = mem_alloc(sizeof(char) * *typename_len_ptr)) == NULL) {
-        apdu_response_code = APDU_RESPONSE_INSUFFICIENT_MEMORY;
-        return false;
+    if (get_structn_ordinal_linear((char *) &data[*data_idx], typename_len, &ordinal)) {
+        if ((ordinal_ptr = mem_alloc(sizeof(uint8_t))) == NULL) {
+            apdu_response_code = APDU_RESPONSE_INSUFFICIENT_MEMORY;
+            return false;
+        }
+        *ordinal_ptr = ordinal;
+        *typedesc_ptr |= TYPENAME_ORDINAL_MASK;
+    } else {
+        if ((typename_len_ptr = mem_alloc(sizeof(uint8_t))) == NULL) {
+            apdu_response_code = APDU_RESPONSE_INSUFFICIENT_MEMORY;
+            return false;
+        }
+        *typename_len_ptr = typename_len;
+        if ((typename = mem_alloc(sizeof(char) * typename_len)) == NULL) {
+            apdu_response_code = APDU_RESPONSE_INSUFFICIENT_MEMORY;
+            return false;
+        }
+        memmove(typename, &data[*data_idx], typename_len);
     }
-    memmove(typename, &data[*data_idx], *typename_len_ptr);
-    *data_idx += *typename_len_ptr;
+    *data_idx += typename_len;
     return true;
 }
 
@@ -685,7 +1098,7 @@ static bool set_struct_field_keyname(const uint8_t *const data, uint8_t *data_id
  * @return whether it was successful
  */
 bool set_struct_field(uint8_t length, const uint8_t *const data) {
-    const typedesc_t *typedesc_ptr;
+    typedesc_t *typedesc_ptr;
     uint8_t data_idx = 0;
 
     if ((data == NULL) || (length == 0)) {
@@ -725,7 +1138,7 @@ bool set_struct_field(uint8_t length, const uint8_t *const data) {
         }
 
     } else if ((*typedesc_ptr & TYPE_MASK) == TYPE_CUSTOM) {
-        if (set_struct_field_custom_typename(data, &data_idx, length) == false) {
+        if (set_struct_field_custom_typename(typedesc_ptr, data, &data_idx, length) == false) {
             return false;
         }
     }
@@ -11,6 +11,11 @@
 #define ARRAY_MASK    (1 << 7)
 #define TYPESIZE_MASK (1 << 6)
 #define TYPENAME_ENUM (0xF)
+// internal TypeDesc flags, cleared from the ones sent by the client
+// custom type name stored as the ordinal of the struct it refers to
+#define TYPENAME_ORDINAL_MASK (1 << 5)
+// custom type name whose first character has been replaced by the struct ordinal
+#define TYPENAME_RESOLVED_MASK (1 << 4)
 
 typedef enum { ARRAY_DYNAMIC = 0, ARRAY_FIXED_SIZE, ARRAY_TYPES_COUNT } e_array_type;
 
@@ -28,9 +33,17 @@ typedef enum {
     TYPES_COUNT
 } e_type;
 
+typedef struct {
+    uint32_t name_hash;
+    const uint8_t *struct_ptr;
+} s_struct_index_entry;
+
 typedef struct {
     uint8_t *structs_array;
     uint8_t *current_struct_fields_array;
+    // built once all the struct definitions have been received
+    const uint8_t **structs_ptrs;
+    const s_struct_index_entry *structs_index;
 } s_typed_data;
 
 typedef uint8_t typedesc_t;
@@ -55,6 +68,11 @@ const uint8_t *get_struct_fields_array(const uint8_t *ptr, uint8_t *const length
 const uint8_t *get_next_struct(const uint8_t *ptr);
 const uint8_t *get_structs_array(uint8_t *const length);
 const uint8_t *get_structn(const char *const name_ptr, const uint8_t name_length);
+const uint8_t *get_struct_field_custom_struct(const uint8_t *field_ptr);
+bool get_struct_field_custom_ordinal(const uint8_t *field_ptr, uint8_t *const ordinal);
+bool get_struct_ordinal(const uint8_t *struct_ptr, uint8_t *const ordinal);
+const uint8_t *get_struct_from_ordinal(uint8_t ordinal);
+bool typed_data_build_index(void);
 bool set_struct_name(uint8_t length, const uint8_t *const name);
 bool set_struct_field(uint8_t length, const uint8_t *const data);
 bool typed_data_init(void);
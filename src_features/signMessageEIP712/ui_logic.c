@@ -11,7 +11,7 @@
 #include "common_utils.h"  // uint256_to_decimal
 #include "common_712.h"
 #include "context_712.h"     // eip712_context_deinit
-#include "uint256.h"         // tostring256 && tostring256_signed
+#include "uint256.h"         // u256_to_decimal && tostring256_signed
 #include "path.h"            // path_get_root_type
 #include "apdu_constants.h"  // APDU response codes
 #include "typed_data.h"
@@ -50,6 +50,8 @@ typedef struct {
 
 typedef struct {
     bool shown;
+    // set whenever a field gets drawn, to know if resuming a batch of values brought one on screen
+    bool redrawn;
     bool end_reached;
     uint8_t filtering_mode;
     uint8_t filters_to_process;
@@ -145,6 +147,7 @@ void ui_712_set_value(const char *str, size_t length) {
  * Redraw the dynamic UI step that shows EIP712 information
  */
 void ui_712_redraw_generic_step(void) {
+    ui_ctx->redrawn = true;
     if (!ui_ctx->shown) {  // Initialize if it is not already
         ui_712_start();
         ui_ctx->shown = true;
@@ -171,11 +174,13 @@ e_eip712_nfs ui_712_next_field(void) {
             ui_ctx->structs_to_review -= 1;
             state = EIP712_FIELD_LATER;
         } else if (!ui_ctx->end_reached) {
-            handle_eip712_return_code(true);
-            state = EIP712_FIELD_INCOMING;
             // So that later when we append to them, we start from an empty string
             explicit_bzero(strings.tmp.tmp, sizeof(strings.tmp.tmp));
             explicit_bzero(strings.tmp.tmp2, sizeof(strings.tmp.tmp2));
+            ui_ctx->redrawn = false;
+            // might resume a batch of values, up to the next one to display
+            handle_eip712_return_code(true);
+            state = ui_ctx->redrawn ? EIP712_FIELD_LATER : EIP712_FIELD_INCOMING;
         }
     }
     return state;
@@ -331,8 +336,9 @@ static bool ui_712_format_int(const uint8_t *data,
                               uint8_t length,
                               bool first,
                               const void *field_ptr) {
+    uint8_t value[INT256_LENGTH];
+    uint8_t typesize = get_struct_field_typesize(field_ptr);
     uint256_t value256;
-    uint128_t value128;
     int32_t value32;
     int16_t value16;
 
@@ -340,18 +346,22 @@ static bool ui_712_format_int(const uint8_t *data,
     if (!first) {
         return false;
     }
-    switch (get_struct_field_typesize(field_ptr) * 8) {
+    switch (typesize * 8) {
         case 256:
-            convertUint256BE(data, length, &value256);
-            tostring256_signed(&value256, 10, strings.tmp.tmp, sizeof(strings.tmp.tmp));
-            break;
         case 128:
-            convertUint128BE(data, length, &value128);
-            tostring128_signed(&value128, 10, strings.tmp.tmp, sizeof(strings.tmp.tmp));
-            break;
         case 64:
-            convertUint64BEto128(data, length, &value128);
-            tostring128_signed(&value128, 10, strings.tmp.tmp, sizeof(strings.tmp.tmp));
+            if (length > typesize) {
+                apdu_response_code = APDU_RESPONSE_INVALID_DATA;
+                return false;
+            }
+            // zero-pad to the type size, then sign-extend to 256 bits
+            memset(value, 0, sizeof(value));
+            memcpy(value + sizeof(value) - length, data, length);
+            if (value[sizeof(value) - typesize] & 0x80) {
+                memset(value, 0xff, sizeof(value) - typesize);
+            }
+            convertUint256BE(value, sizeof(value), &value256);
+            tostring256_signed(&value256, 10, strings.tmp.tmp, sizeof(strings.tmp.tmp));
             break;
         case 32:
             value32 = 0;
@@ -400,7 +410,7 @@ static bool ui_712_format_uint(const uint8_t *data, uint8_t length, bool first)
         return false;
     }
     convertUint256BE(data, length, &value256);
-    tostring256(&value256, 10, strings.tmp.tmp, sizeof(strings.tmp.tmp));
+    u256_to_decimal(&value256, 0, strings.tmp.tmp, sizeof(strings.tmp.tmp));
     return true;
 }
 
@@ -616,8 +626,13 @@ void ui_712_end_sign(void) {
  * Initializes the UI context structure in memory
  */
 bool ui_712_init(void) {
-    if ((ui_ctx = MEM_ALLOC_AND_ALIGN_TYPE(*ui_ctx))) {
+    e_mem_tag tag = mem_set_tag(MEM_TAG_EIP712_UI);
+
+    ui_ctx = MEM_ALLOC_AND_ALIGN_TYPE(*ui_ctx);
+    mem_set_tag(tag);
+    if (ui_ctx != NULL) {
         ui_ctx->shown = false;
+        ui_ctx->redrawn = false;
         ui_ctx->end_reached = false;
         ui_ctx->filtering_mode = EIP712_FILTERING_BASIC;
         explicit_bzero(&ui_ctx->amount, sizeof(ui_ctx->amount));
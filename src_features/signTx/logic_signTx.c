@@ -11,6 +11,8 @@
 #include "crypto_helpers.h"
 #include "format.h"
 #include "manage_asset_info.h"
+#include "derived_key_cache.h"
+#include "plugin_batch.h"
 
 #define ERR_SILENT_MODE_CHECK_FAILED 0x6001
 
@@ -34,6 +36,45 @@ static uint32_t splitBinaryParameterPart(char *result, size_t result_size, uint8
     }
 }
 
+/**
+ * Give all the complete parameters of the current chunk to the plugin in a single call
+ *
+ * Only done for the plugins that declared an interface version handling it.
+ *
+ * @param[in,out] context the transaction parsing context
+ * @return CUSTOM_NOT_HANDLED if the parameters have to be given one by one
+ */
+static customStatus_e provide_plugin_parameters(txContext_t *context) {
+    ethPluginProvideParameters_t pluginProvideParameters;
+    uint32_t offset;
+    uint8_t count;
+
+    count = plugin_batch_count(dataContext.tokenContext.pluginBatchSupported,
+                               dataContext.tokenContext.fieldOffset,
+                               context->commandLength,
+                               context->currentFieldLength - context->currentFieldPos);
+    if (count == 0) {
+        return CUSTOM_NOT_HANDLED;
+    }
+    offset = plugin_parameter_offset(dataContext.tokenContext.fieldIndex);
+    eth_plugin_prepare_provide_parameters(&pluginProvideParameters,
+                                          context->workBuffer,
+                                          offset,
+                                          count);
+    if (eth_plugin_call(ETH_PLUGIN_PROVIDE_PARAMETERS, (void *) &pluginProvideParameters) <=
+        ETH_PLUGIN_RESULT_UNSUCCESSFUL) {
+        PRINTF("Plugin parameters call failed\n");
+        return CUSTOM_FAULT;
+    }
+    copyTxData(context, NULL, count * PLUGIN_PARAMETER_SIZE);
+    dataContext.tokenContext.fieldIndex += count;
+    if (context->currentFieldPos == context->currentFieldLength) {
+        context->currentField++;
+        context->processingField = false;
+    }
+    return CUSTOM_HANDLED;
+}
+
 customStatus_e customProcessor(txContext_t *context) {
     if (((context->txType == LEGACY && context->currentField == LEGACY_RLP_DATA) ||
          (context->txType == EIP2930 && context->currentField == EIP2930_RLP_DATA) ||
@@ -95,6 +136,12 @@ customStatus_e customProcessor(txContext_t *context) {
                 dataContext.tokenContext.pluginStatus <= ETH_PLUGIN_RESULT_UNSUCCESSFUL) {
                 return CUSTOM_NOT_HANDLED;
             }
+            if (dataContext.tokenContext.pluginStatus >= ETH_PLUGIN_RESULT_SUCCESSFUL) {
+                customStatus_e status = provide_plugin_parameters(context);
+                if (status != CUSTOM_NOT_HANDLED) {
+                    return status;
+                }
+            }
             blockSize = 32 - (dataContext.tokenContext.fieldOffset % 32);
         }
 
@@ -126,7 +173,8 @@ customStatus_e customProcessor(txContext_t *context) {
                 ethPluginProvideParameter_t pluginProvideParameter;
                 eth_plugin_prepare_provide_parameter(&pluginProvideParameter,
                                                      dataContext.tokenContext.data,
-                                                     dataContext.tokenContext.fieldIndex * 32 + 4);
+                                                     plugin_parameter_offset(
+                                                         dataContext.tokenContext.fieldIndex));
                 if (!eth_plugin_call(ETH_PLUGIN_PROVIDE_PARAMETER,
                                      (void *) &pluginProvideParameter)) {
                     PRINTF("Plugin parameter call failed\n");
@@ -194,45 +242,30 @@ static void address_to_string(uint8_t *in,
     }
 }
 
-static void raw_fee_to_string(uint256_t *rawFee, char *displayBuffer, uint32_t displayBufferSize) {
-    uint64_t chain_id = get_tx_chain_id();
-    const char *feeTicker = get_displayable_ticker(&chain_id, chainConfig);
-    uint8_t tickerOffset = 0;
-    uint32_t i;
+// Format an amount as "<ticker> <value>", with the value adjusted to the given decimals
+static bool amount_to_string(const uint256_t *amount,
+                             uint8_t decimals,
+                             const char *ticker,
+                             char *out,
+                             size_t out_size) {
+    size_t ticker_len = strlen(ticker);
 
-    tostring256(rawFee, 10, (char *) (G_io_apdu_buffer + 100), 100);
-    i = 0;
-    while (G_io_apdu_buffer[100 + i]) {
-        i++;
+    if ((ticker_len + 1) >= out_size) {
+        return false;
     }
-    adjustDecimals((char *) (G_io_apdu_buffer + 100),
-                   i,
-                   (char *) G_io_apdu_buffer,
-                   100,
-                   WEI_TO_ETHER);
-    i = 0;
-    tickerOffset = 0;
-    memset(displayBuffer, 0, displayBufferSize);
-
-    while (feeTicker[tickerOffset]) {
-        if ((uint32_t) tickerOffset >= displayBufferSize) {
-            break;
-        }
-
-        displayBuffer[tickerOffset] = feeTicker[tickerOffset];
-        tickerOffset++;
-    }
-    if ((uint32_t) tickerOffset < displayBufferSize) displayBuffer[tickerOffset++] = ' ';
-    while (G_io_apdu_buffer[i]) {
-        if ((uint32_t) (tickerOffset) + i >= displayBufferSize) {
-            break;
-        }
-        displayBuffer[tickerOffset + i] = G_io_apdu_buffer[i];
-        i++;
+    memcpy(out, ticker, ticker_len);
+    if (ticker_len > 0) {
+        out[ticker_len++] = ' ';
     }
+    return u256_to_decimal(amount, decimals, out + ticker_len, out_size - ticker_len);
+}
 
-    if ((uint32_t) (tickerOffset) + i < displayBufferSize) {
-        displayBuffer[tickerOffset + i] = '\0';
+static void raw_fee_to_string(uint256_t *rawFee, char *displayBuffer, uint32_t displayBufferSize) {
+    uint64_t chain_id = get_tx_chain_id();
+    const char *feeTicker = get_displayable_ticker(&chain_id, chainConfig);
+
+    if (!amount_to_string(rawFee, WEI_TO_ETHER, feeTicker, displayBuffer, displayBufferSize)) {
+        THROW(EXCEPTION_OVERFLOW);
     }
 }
 
@@ -278,11 +311,16 @@ static void get_network_as_string(char *out, size_t out_size) {
 }
 
 static void get_public_key(uint8_t *out, uint8_t outLength) {
+#ifdef TARGET_NANOS
     uint8_t raw_pubkey[65];
+#else
+    const derived_key_t *key;
+#endif
 
     if (outLength < ADDRESS_LENGTH) {
         return;
     }
+#ifdef TARGET_NANOS
     if (bip32_derive_get_pubkey_256(CX_CURVE_256K1,
                                     tmpCtx.transactionContext.bip32.path,
                                     tmpCtx.transactionContext.bip32.length,
@@ -293,6 +331,14 @@ static void get_public_key(uint8_t *out, uint8_t outLength) {
     }
 
     getEthAddressFromRawKey(raw_pubkey, out);
+#else
+    if ((key = get_derived_key(tmpCtx.transactionContext.bip32.path,
+                               tmpCtx.transactionContext.bip32.length,
+                               chainConfig->chainId)) == NULL) {
+        THROW(APDU_RESPONSE_UNKNOWN);
+    }
+    memcpy(out, key->address, ADDRESS_LENGTH);
+#endif
 }
 
 /* Local implementation of strncasecmp, workaround of the segfaulting base implem
@@ -312,6 +358,7 @@ static int strcasecmp_workaround(const char *str1, const char *str2) {
 
 __attribute__((noinline)) static bool finalize_parsing_helper(void) {
     char displayBuffer[50];
+    uint256_t value;
     uint8_t decimals = WEI_TO_ETHER;
     uint64_t chain_id = get_tx_chain_id();
     const char *ticker = get_displayable_ticker(&chain_id, chainConfig);
@@ -361,16 +408,20 @@ __attribute__((noinline)) static bool finalize_parsing_helper(void) {
         ethPluginProvideInfo_t pluginProvideInfo;
         eth_plugin_prepare_provide_info(&pluginProvideInfo);
         if ((pluginFinalize.tokenLookup1 != NULL) || (pluginFinalize.tokenLookup2 != NULL)) {
+            uint64_t chain_id = get_tx_chain_id();
+
             if (pluginFinalize.tokenLookup1 != NULL) {
                 PRINTF("Lookup1: %.*H\n", ADDRESS_LENGTH, pluginFinalize.tokenLookup1);
-                pluginProvideInfo.item1 = get_asset_info_by_addr(pluginFinalize.tokenLookup1);
+                pluginProvideInfo.item1 =
+                    get_asset_info_by_addr(pluginFinalize.tokenLookup1, chain_id);
                 if (pluginProvideInfo.item1 != NULL) {
                     PRINTF("Token1 ticker: %s\n", pluginProvideInfo.item1->token.ticker);
                 }
             }
             if (pluginFinalize.tokenLookup2 != NULL) {
                 PRINTF("Lookup2: %.*H\n", ADDRESS_LENGTH, pluginFinalize.tokenLookup2);
-                pluginProvideInfo.item2 = get_asset_info_by_addr(pluginFinalize.tokenLookup2);
+                pluginProvideInfo.item2 =
+                    get_asset_info_by_addr(pluginFinalize.tokenLookup2, chain_id);
                 if (pluginProvideInfo.item2 != NULL) {
                     PRINTF("Token2 ticker: %s\n", pluginProvideInfo.item2->token.ticker);
                 }
@@ -458,12 +509,10 @@ __attribute__((noinline)) static bool finalize_parsing_helper(void) {
 
         // Format the amount in a temporary buffer, if in swap case compare it with validated
         // amount, else commit it
-        if (!amountToString(tmpContent.txContent.value.value,
-                            tmpContent.txContent.value.length,
-                            decimals,
-                            ticker,
-                            displayBuffer,
-                            sizeof(displayBuffer))) {
+        convertUint256BE(tmpContent.txContent.value.value,
+                         tmpContent.txContent.value.length,
+                         &value);
+        if (!amount_to_string(&value, decimals, ticker, displayBuffer, sizeof(displayBuffer))) {
             PRINTF("OVERFLOW, amount to string failed\n");
             THROW(EXCEPTION_OVERFLOW);
         }
@@ -6,15 +6,14 @@
 #include "eth_plugin_internal.h"
 #include "eth_plugin_handler.h"
 
-static const uint8_t ERC1155_APPROVE_FOR_ALL_SELECTOR[SELECTOR_SIZE] = {0xa2, 0x2c, 0xb4, 0x65};
-static const uint8_t ERC1155_SAFE_TRANSFER_SELECTOR[SELECTOR_SIZE] = {0xf2, 0x42, 0x43, 0x2a};
-static const uint8_t ERC1155_SAFE_BATCH_TRANSFER[SELECTOR_SIZE] = {0x2e, 0xb2, 0xc2, 0xd6};
-
-const uint8_t *const ERC1155_SELECTORS[SELECTORS_COUNT] = {
-    ERC1155_APPROVE_FOR_ALL_SELECTOR,
-    ERC1155_SAFE_TRANSFER_SELECTOR,
-    ERC1155_SAFE_BATCH_TRANSFER,
-};
+// setApprovalForAll(address,bool)
+static const uint8_t ERC1155_APPROVE_FOR_ALL_ABI[] = {ABI_TYPE_WORD, ABI_TYPE_WORD};
+// safeTransferFrom(address,address,uint256,uint256,bytes)
+static const uint8_t ERC1155_SAFE_TRANSFER_ABI[] =
+    {ABI_TYPE_WORD, ABI_TYPE_WORD, ABI_TYPE_WORD, ABI_TYPE_WORD, ABI_TYPE_BYTES};
+// safeBatchTransferFrom(address,address,uint256[],uint256[],bytes)
+static const uint8_t ERC1155_SAFE_BATCH_TRANSFER_ABI[] =
+    {ABI_TYPE_WORD, ABI_TYPE_WORD, ABI_TYPE_ARRAY, ABI_TYPE_ARRAY, ABI_TYPE_BYTES};
 
 static void handle_init_contract(void *parameters) {
     ethPluginInitContract_t *msg = (ethPluginInitContract_t *) parameters;
@@ -25,16 +24,10 @@ static void handle_init_contract(void *parameters) {
         msg->result = ETH_PLUGIN_RESULT_ERROR;
         return;
     }
-    uint8_t i;
-    for (i = 0; i < SELECTORS_COUNT; i++) {
-        if (memcmp(PIC(ERC1155_SELECTORS[i]), msg->selector, SELECTOR_SIZE) == 0) {
-            context->selectorIndex = i;
-            break;
-        }
-    }
+    context->selectorIndex = dataContext.tokenContext.selectorIndex;
 
     // No selector found.
-    if (i == SELECTORS_COUNT) {
+    if (context->selectorIndex == PLUGIN_SELECTOR_UNKNOWN) {
         PRINTF("Unknown erc1155 selector %.*H\n", SELECTOR_SIZE, msg->selector);
         msg->result = ETH_PLUGIN_RESULT_FALLBACK;
         return;
@@ -42,12 +35,20 @@ static void handle_init_contract(void *parameters) {
 
     msg->result = ETH_PLUGIN_RESULT_OK;
     switch (context->selectorIndex) {
-        case SAFE_TRANSFER:
-        case SAFE_BATCH_TRANSFER:
-            context->next_param = FROM;
+        case ERC1155_SAFE_TRANSFER:
+            abi_decoder_init(&context->decoder,
+                             ERC1155_SAFE_TRANSFER_ABI,
+                             sizeof(ERC1155_SAFE_TRANSFER_ABI));
+            break;
+        case ERC1155_SAFE_BATCH_TRANSFER:
+            abi_decoder_init(&context->decoder,
+                             ERC1155_SAFE_BATCH_TRANSFER_ABI,
+                             sizeof(ERC1155_SAFE_BATCH_TRANSFER_ABI));
             break;
-        case SET_APPROVAL_FOR_ALL:
-            context->next_param = OPERATOR;
+        case ERC1155_SET_APPROVAL_FOR_ALL:
+            abi_decoder_init(&context->decoder,
+                             ERC1155_APPROVE_FOR_ALL_ABI,
+                             sizeof(ERC1155_APPROVE_FOR_ALL_ABI));
             break;
         default:
             PRINTF("Unsupported selector index: %d\n", context->selectorIndex);
@@ -60,7 +61,12 @@ static void handle_finalize(void *parameters) {
     ethPluginFinalize_t *msg = (ethPluginFinalize_t *) parameters;
     erc1155_context_t *context = (erc1155_context_t *) msg->pluginContext;
 
-    if (context->selectorIndex != SAFE_BATCH_TRANSFER) {
+    if (!abi_decoder_done(&context->decoder)) {
+        PRINTF("Truncated ERC1155 parameters\n");
+        msg->result = ETH_PLUGIN_RESULT_ERROR;
+        return;
+    }
+    if (context->selectorIndex != ERC1155_SAFE_BATCH_TRANSFER) {
         msg->tokenLookup1 = msg->pluginSharedRO->txContent->destination;
     } else {
         msg->tokenLookup1 = NULL;
@@ -68,13 +74,13 @@ static void handle_finalize(void *parameters) {
 
     msg->tokenLookup2 = NULL;
     switch (context->selectorIndex) {
-        case SAFE_TRANSFER:
+        case ERC1155_SAFE_TRANSFER:
             msg->numScreens = 5;
             break;
-        case SAFE_BATCH_TRANSFER:
+        case ERC1155_SAFE_BATCH_TRANSFER:
             msg->numScreens = 4;
             break;
-        case SET_APPROVAL_FOR_ALL:
+        case ERC1155_SET_APPROVAL_FOR_ALL:
             msg->numScreens = 3;
             break;
         default:
@@ -107,7 +113,7 @@ static void handle_query_contract_id(void *parameters) {
     strlcpy(msg->name, "NFT", msg->nameLength);
 
     switch (context->selectorIndex) {
-        case SET_APPROVAL_FOR_ALL:
+        case ERC1155_SET_APPROVAL_FOR_ALL:
 #ifdef HAVE_NBGL
             strlcpy(msg->version, "manage", msg->versionLength);
             strlcat(msg->name, " allowance", msg->nameLength);
@@ -115,10 +121,10 @@ static void handle_query_contract_id(void *parameters) {
             strlcpy(msg->version, "Allowance", msg->versionLength);
 #endif
             break;
-        case SAFE_TRANSFER:
+        case ERC1155_SAFE_TRANSFER:
             strlcpy(msg->version, "Transfer", msg->versionLength);
             break;
-        case SAFE_BATCH_TRANSFER:
+        case ERC1155_SAFE_BATCH_TRANSFER:
             strlcpy(msg->version, "Batch Transfer", msg->versionLength);
             break;
         default:
@@ -8,43 +8,27 @@
 #include "ethUstream.h"
 #include "uint256.h"
 #include "asset_info.h"
+#include "abi_decoder.h"
+#include "plugin_selectors.h"
 
 // Internal plugin for EIP 1155: https://eips.ethereum.org/EIPS/eip-1155
 
-typedef enum {
-    SET_APPROVAL_FOR_ALL,
-    SAFE_TRANSFER,
-    SAFE_BATCH_TRANSFER,
-    SELECTORS_COUNT
-} erc1155_selector_t;
-
-typedef enum {
-    FROM,
-    TO,
-    TOKEN_IDS_OFFSET,
-    TOKEN_IDS_LENGTH,
-    TOKEN_ID,
-    VALUE_OFFSET,
-    VALUE_LENGTH,
-    VALUE,
-    OPERATOR,
-    APPROVED,
-    NONE,
-} erc1155_selector_field;
+// Position of the parameters in the ABI schema of each selector
+#define APPROVED_OPERATOR  0
+#define APPROVED_APPROVED  1
+#define TRANSFER_TO        1
+#define TRANSFER_TOKEN_ID  2
+#define TRANSFER_VALUE     3
 
 typedef struct erc1155_context_t {
     uint8_t address[ADDRESS_LENGTH];
     uint8_t tokenId[INT256_LENGTH];
     uint256_t value;
 
-    uint16_t ids_array_len;
-    uint32_t ids_offset;
-    uint16_t values_array_len;
-    uint32_t values_offset;
     uint16_t array_index;
 
     bool approved;
-    erc1155_selector_field next_param;
+    abi_decoder_t decoder;
     uint8_t selectorIndex;
 } erc1155_context_t;
 
@@ -6,91 +6,57 @@
 #include "eth_plugin_internal.h"
 #include "common_utils.h"
 
-static void handle_safe_transfer(ethPluginProvideParameter_t *msg, erc1155_context_t *context) {
+static void handle_safe_transfer(erc1155_context_t *context, const abi_event_t *event) {
     uint8_t new_value[INT256_LENGTH];
 
-    switch (context->next_param) {
-        case FROM:
-            context->next_param = TO;
-            break;
-        case TO:
-            copy_address(context->address, msg->parameter, sizeof(context->address));
-            context->next_param = TOKEN_ID;
+    if (event->type != ABI_EVENT_WORD) {
+        // Some extra data might be present so don't error.
+        return;
+    }
+    switch (event->param) {
+        case TRANSFER_TO:
+            copy_address(context->address, event->word, sizeof(context->address));
             break;
-        case TOKEN_ID:
-            copy_parameter(context->tokenId, msg->parameter, sizeof(context->tokenId));
-            context->next_param = VALUE;
+        case TRANSFER_TOKEN_ID:
+            copy_parameter(context->tokenId, event->word, sizeof(context->tokenId));
             break;
-        case VALUE:
-            copy_parameter(new_value, msg->parameter, sizeof(new_value));
+        case TRANSFER_VALUE:
+            copy_parameter(new_value, event->word, sizeof(new_value));
             convertUint256BE(new_value, INT256_LENGTH, &context->value);
-            context->next_param = NONE;
             break;
         default:
-            // Some extra data might be present so don't error.
             break;
     }
 }
 
-static void handle_batch_transfer(ethPluginProvideParameter_t *msg, erc1155_context_t *context) {
+static void handle_batch_transfer(erc1155_context_t *context, const abi_event_t *event) {
     uint256_t new_value;
 
-    switch (context->next_param) {
-        case FROM:
-            context->next_param = TO;
-            break;
-        case TO:
-            copy_address(context->address, msg->parameter, sizeof(context->address));
-            context->next_param = TOKEN_IDS_OFFSET;
-            break;
-        case TOKEN_IDS_OFFSET:
-            context->ids_offset =
-                U4BE(msg->parameter, PARAMETER_LENGTH - sizeof(context->ids_offset)) + 4;
-            context->next_param = VALUE_OFFSET;
-            break;
-        case VALUE_OFFSET:
-            context->values_offset =
-                U4BE(msg->parameter, PARAMETER_LENGTH - sizeof(context->values_offset)) + 4;
-            context->next_param = TOKEN_IDS_LENGTH;
-            break;
-        case TOKEN_IDS_LENGTH:
-            if ((msg->parameterOffset + PARAMETER_LENGTH) > context->ids_offset) {
-                context->ids_array_len =
-                    U2BE(msg->parameter, PARAMETER_LENGTH - sizeof(context->ids_array_len));
-                context->next_param = TOKEN_ID;
-                // set to zero for next step
-                context->array_index = 0;
-            }
-            break;
-        case TOKEN_ID:
-            // don't copy anything since we won't display it
-            if (--context->ids_array_len == 0) {
-                context->next_param = VALUE_LENGTH;
+    switch (event->type) {
+        case ABI_EVENT_WORD:
+            if (event->param == TRANSFER_TO) {
+                copy_address(context->address, event->word, sizeof(context->address));
             }
-            context->array_index++;
             break;
-        case VALUE_LENGTH:
-            if ((msg->parameterOffset + PARAMETER_LENGTH) > context->values_offset) {
-                context->values_array_len =
-                    U2BE(msg->parameter, PARAMETER_LENGTH - sizeof(context->values_array_len));
-                if (context->values_array_len != context->array_index) {
+        case ABI_EVENT_LENGTH:
+            if (event->param == TRANSFER_TOKEN_ID) {
+                context->array_index = event->value;
+            } else if (event->param == TRANSFER_VALUE) {
+                if (event->value != context->array_index) {
                     PRINTF("Token ids and values array sizes mismatch!");
                 }
-                context->next_param = VALUE;
-                // set to zero for next step
-                context->array_index = 0;
+                context->array_index = event->value;
                 explicit_bzero(&context->value, sizeof(context->value));
             }
             break;
-        case VALUE:
-            // put it temporarily in token id since we don't use it in batch transfer
-            copy_parameter(context->tokenId, msg->parameter, sizeof(context->value));
-            convertUint256BE(context->tokenId, sizeof(context->tokenId), &new_value);
-            add256(&context->value, &new_value, &context->value);
-            if (--context->values_array_len == 0) {
-                context->next_param = NONE;
+        case ABI_EVENT_ELEMENT:
+            // don't copy the token ids since we won't display them
+            if (event->param == TRANSFER_VALUE) {
+                // put it temporarily in token id since we don't use it in batch transfer
+                copy_parameter(context->tokenId, event->word, sizeof(context->tokenId));
+                convertUint256BE(context->tokenId, sizeof(context->tokenId), &new_value);
+                add256(&context->value, &new_value, &context->value);
             }
-            context->array_index++;
             break;
         default:
             // Some extra data might be present so don't error.
@@ -98,26 +64,25 @@ static void handle_batch_transfer(ethPluginProvideParameter_t *msg, erc1155_cont
     }
 }
 
-static void handle_approval_for_all(ethPluginProvideParameter_t *msg, erc1155_context_t *context) {
-    switch (context->next_param) {
-        case OPERATOR:
-            context->next_param = APPROVED;
-            copy_address(context->address, msg->parameter, sizeof(context->address));
-            break;
-        case APPROVED:
-            context->approved = msg->parameter[PARAMETER_LENGTH - 1];
-            context->next_param = NONE;
-            break;
-        default:
-            PRINTF("Param %d not supported\n", context->next_param);
-            msg->result = ETH_PLUGIN_RESULT_ERROR;
-            break;
+static void handle_approval_for_all(ethPluginProvideParameter_t *msg,
+                                    erc1155_context_t *context,
+                                    const abi_event_t *event) {
+    if (event->type != ABI_EVENT_WORD) {
+        PRINTF("Param %d not supported\n", event->param);
+        msg->result = ETH_PLUGIN_RESULT_ERROR;
+        return;
+    }
+    if (event->param == APPROVED_OPERATOR) {
+        copy_address(context->address, event->word, sizeof(context->address));
+    } else {
+        context->approved = event->word[PARAMETER_LENGTH - 1];
     }
 }
 
 void handle_provide_parameter_1155(void *parameters) {
     ethPluginProvideParameter_t *msg = (ethPluginProvideParameter_t *) parameters;
     erc1155_context_t *context = (erc1155_context_t *) msg->pluginContext;
+    abi_event_t event;
 
     PRINTF("erc1155 plugin provide parameter %d %.*H\n",
            msg->parameterOffset,
@@ -126,19 +91,22 @@ void handle_provide_parameter_1155(void *parameters) {
 
     msg->result = ETH_PLUGIN_RESULT_SUCCESSFUL;
 
-    // if (context->targetOffset > SELECTOR_SIZE &&
-    //     context->targetOffset != msg->parameterOffset - SELECTOR_SIZE) {
-    //     return;
-    // }
+    if (!abi_decoder_feed(&context->decoder,
+                          msg->parameterOffset - SELECTOR_SIZE,
+                          msg->parameter,
+                          &event)) {
+        msg->result = ETH_PLUGIN_RESULT_ERROR;
+        return;
+    }
     switch (context->selectorIndex) {
-        case SAFE_TRANSFER:
-            handle_safe_transfer(msg, context);
+        case ERC1155_SAFE_TRANSFER:
+            handle_safe_transfer(context, &event);
             break;
-        case SAFE_BATCH_TRANSFER:
-            handle_batch_transfer(msg, context);
+        case ERC1155_SAFE_BATCH_TRANSFER:
+            handle_batch_transfer(context, &event);
             break;
-        case SET_APPROVAL_FOR_ALL:
-            handle_approval_for_all(msg, context);
+        case ERC1155_SET_APPROVAL_FOR_ALL:
+            handle_approval_for_all(msg, context, &event);
             break;
         default:
             PRINTF("Selector index %d not supported\n", context->selectorIndex);
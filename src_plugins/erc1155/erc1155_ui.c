@@ -138,13 +138,13 @@ void handle_query_contract_ui_1155(void *parameters) {
 
     msg->result = ETH_PLUGIN_RESULT_OK;
     switch (context->selectorIndex) {
-        case SET_APPROVAL_FOR_ALL:
+        case ERC1155_SET_APPROVAL_FOR_ALL:
             set_approval_for_all_ui(msg, context);
             break;
-        case SAFE_TRANSFER:
+        case ERC1155_SAFE_TRANSFER:
             set_transfer_ui(msg, context);
             break;
-        case SAFE_BATCH_TRANSFER:
+        case ERC1155_SAFE_BATCH_TRANSFER:
             set_batch_transfer_ui(msg, context);
             break;
         default:
@@ -5,8 +5,7 @@
 #include "plugin_utils.h"
 #include "ethUstream.h"
 #include "common_utils.h"
-
-typedef enum { ERC20_TRANSFER = 0, ERC20_APPROVE } erc20Selector_t;
+#include "abi_decoder.h"
 
 typedef enum { TARGET_ADDRESS = 0, TARGET_CONTRACT } targetType_t;
 
@@ -20,8 +19,12 @@ typedef struct erc20_parameters_t {
     uint8_t decimals;
     uint8_t target;
     char contract_name[MAX_CONTRACT_NAME_LEN];
+    abi_decoder_t decoder;
 } erc20_parameters_t;
 
+// transfer(address,uint256) & approve(address,uint256)
+static const uint8_t ERC20_ABI[] = {ABI_TYPE_WORD, ABI_TYPE_WORD};
+
 typedef struct contract_t {
     char name[MAX_CONTRACT_NAME_LEN];
     uint8_t address[ADDRESS_LENGTH];
@@ -83,19 +86,13 @@ void erc20_plugin_call(int message, void *parameters) {
                 PRINTF("Err: Transaction amount is not 0\n");
                 msg->result = ETH_PLUGIN_RESULT_ERROR;
             } else {
-                size_t i;
-                for (i = 0; i < NUM_ERC20_SELECTORS; i++) {
-                    if (memcmp((uint8_t *) PIC(ERC20_SELECTORS[i]), msg->selector, SELECTOR_SIZE) ==
-                        0) {
-                        context->selectorIndex = i;
-                        break;
-                    }
-                }
-                if (i == NUM_ERC20_SELECTORS) {
+                context->selectorIndex = dataContext.tokenContext.selectorIndex;
+                if (context->selectorIndex == PLUGIN_SELECTOR_UNKNOWN) {
                     PRINTF("Unknown selector %.*H\n", SELECTOR_SIZE, msg->selector);
                     msg->result = ETH_PLUGIN_RESULT_ERROR;
                     break;
                 }
+                abi_decoder_init(&context->decoder, ERC20_ABI, sizeof(ERC20_ABI));
                 PRINTF("erc20 plugin init\n");
                 msg->result = ETH_PLUGIN_RESULT_OK;
             }
@@ -108,27 +105,32 @@ void erc20_plugin_call(int message, void *parameters) {
                    msg->parameterOffset,
                    32,
                    msg->parameter);
-            switch (msg->parameterOffset) {
-                case 4:
-                    memmove(context->destinationAddress, msg->parameter + 12, 20);
-                    msg->result = ETH_PLUGIN_RESULT_OK;
-                    break;
-                case 4 + 32:
-                    memmove(context->amount, msg->parameter, 32);
-                    msg->result = ETH_PLUGIN_RESULT_OK;
-                    break;
-                default:
-                    PRINTF("Unhandled parameter offset\n");
-                    msg->result = ETH_PLUGIN_RESULT_ERROR;
-                    break;
+            abi_event_t event;
+            if (!abi_decoder_feed(&context->decoder,
+                                  msg->parameterOffset - SELECTOR_SIZE,
+                                  msg->parameter,
+                                  &event) ||
+                (event.type != ABI_EVENT_WORD)) {
+                PRINTF("Unhandled parameter offset\n");
+                msg->result = ETH_PLUGIN_RESULT_ERROR;
+                break;
             }
+            if (event.param == 0) {
+                memmove(context->destinationAddress, event.word + 12, 20);
+            } else {
+                memmove(context->amount, event.word, 32);
+            }
+            msg->result = ETH_PLUGIN_RESULT_OK;
         } break;
 
         case ETH_PLUGIN_FINALIZE: {
             ethPluginFinalize_t *msg = (ethPluginFinalize_t *) parameters;
             erc20_parameters_t *context = (erc20_parameters_t *) msg->pluginContext;
             PRINTF("erc20 plugin finalize\n");
-            if (context->selectorIndex == ERC20_TRANSFER) {
+            if (!abi_decoder_done(&context->decoder)) {
+                PRINTF("Truncated ERC20 parameters\n");
+                msg->result = ETH_PLUGIN_RESULT_ERROR;
+            } else if (context->selectorIndex == ERC20_TRANSFER) {
                 msg->tokenLookup1 = msg->pluginSharedRO->txContent->destination;
                 msg->amount = context->amount;
                 msg->address = context->destinationAddress;
@@ -7,19 +7,15 @@
 #include "eth_plugin_interface.h"
 #include "eth_plugin_handler.h"
 
-static const uint8_t ERC721_APPROVE_SELECTOR[SELECTOR_SIZE] = {0x09, 0x5e, 0xa7, 0xb3};
-static const uint8_t ERC721_APPROVE_FOR_ALL_SELECTOR[SELECTOR_SIZE] = {0xa2, 0x2c, 0xb4, 0x65};
-static const uint8_t ERC721_TRANSFER_SELECTOR[SELECTOR_SIZE] = {0x23, 0xb8, 0x72, 0xdd};
-static const uint8_t ERC721_SAFE_TRANSFER_SELECTOR[SELECTOR_SIZE] = {0x42, 0x84, 0x2e, 0x0e};
-static const uint8_t ERC721_SAFE_TRANSFER_DATA_SELECTOR[SELECTOR_SIZE] = {0xb8, 0x8d, 0x4f, 0xde};
-
-const uint8_t *const ERC721_SELECTORS[SELECTORS_COUNT] = {
-    ERC721_APPROVE_SELECTOR,
-    ERC721_APPROVE_FOR_ALL_SELECTOR,
-    ERC721_TRANSFER_SELECTOR,
-    ERC721_SAFE_TRANSFER_SELECTOR,
-    ERC721_SAFE_TRANSFER_DATA_SELECTOR,
-};
+// approve(address,uint256) & setApprovalForAll(address,bool)
+static const uint8_t ERC721_APPROVE_ABI[] = {ABI_TYPE_WORD, ABI_TYPE_WORD};
+// transferFrom(address,address,uint256) & safeTransferFrom(address,address,uint256)
+static const uint8_t ERC721_TRANSFER_ABI[] = {ABI_TYPE_WORD, ABI_TYPE_WORD, ABI_TYPE_WORD};
+// safeTransferFrom(address,address,uint256,bytes)
+static const uint8_t ERC721_SAFE_TRANSFER_DATA_ABI[] = {ABI_TYPE_WORD,
+                                                        ABI_TYPE_WORD,
+                                                        ABI_TYPE_WORD,
+                                                        ABI_TYPE_BYTES};
 
 static void handle_init_contract(void *parameters) {
     ethPluginInitContract_t *msg = (ethPluginInitContract_t *) parameters;
@@ -30,16 +26,10 @@ static void handle_init_contract(void *parameters) {
         msg->result = ETH_PLUGIN_RESULT_ERROR;
         return;
     }
-    uint8_t i;
-    for (i = 0; i < SELECTORS_COUNT; i++) {
-        if (memcmp(PIC(ERC721_SELECTORS[i]), msg->selector, SELECTOR_SIZE) == 0) {
-            context->selectorIndex = i;
-            break;
-        }
-    }
+    context->selectorIndex = dataContext.tokenContext.selectorIndex;
 
     // No selector found.
-    if (i == SELECTORS_COUNT) {
+    if (context->selectorIndex == PLUGIN_SELECTOR_UNKNOWN) {
         PRINTF("Unknown erc721 selector %.*H\n", SELECTOR_SIZE, msg->selector);
         msg->result = ETH_PLUGIN_RESULT_FALLBACK;
         return;
@@ -47,14 +37,18 @@ static void handle_init_contract(void *parameters) {
 
     msg->result = ETH_PLUGIN_RESULT_OK;
     switch (context->selectorIndex) {
-        case SET_APPROVAL_FOR_ALL:
-        case APPROVE:
-            context->next_param = OPERATOR;
+        case ERC721_SET_APPROVAL_FOR_ALL:
+        case ERC721_APPROVE:
+            abi_decoder_init(&context->decoder, ERC721_APPROVE_ABI, sizeof(ERC721_APPROVE_ABI));
+            break;
+        case ERC721_SAFE_TRANSFER:
+        case ERC721_TRANSFER:
+            abi_decoder_init(&context->decoder, ERC721_TRANSFER_ABI, sizeof(ERC721_TRANSFER_ABI));
             break;
-        case SAFE_TRANSFER:
-        case SAFE_TRANSFER_DATA:
-        case TRANSFER:
-            context->next_param = FROM;
+        case ERC721_SAFE_TRANSFER_DATA:
+            abi_decoder_init(&context->decoder,
+                             ERC721_SAFE_TRANSFER_DATA_ABI,
+                             sizeof(ERC721_SAFE_TRANSFER_DATA_ABI));
             break;
         default:
             PRINTF("Unsupported selector index: %d\n", context->selectorIndex);
@@ -67,16 +61,21 @@ static void handle_finalize(void *parameters) {
     ethPluginFinalize_t *msg = (ethPluginFinalize_t *) parameters;
     erc721_context_t *context = (erc721_context_t *) msg->pluginContext;
 
+    if (!abi_decoder_done(&context->decoder)) {
+        PRINTF("Truncated ERC721 parameters\n");
+        msg->result = ETH_PLUGIN_RESULT_ERROR;
+        return;
+    }
     msg->tokenLookup1 = msg->pluginSharedRO->txContent->destination;
     msg->tokenLookup2 = NULL;
     switch (context->selectorIndex) {
-        case TRANSFER:
-        case SAFE_TRANSFER:
-        case SAFE_TRANSFER_DATA:
-        case APPROVE:
+        case ERC721_TRANSFER:
+        case ERC721_SAFE_TRANSFER:
+        case ERC721_SAFE_TRANSFER_DATA:
+        case ERC721_APPROVE:
             msg->numScreens = 4;
             break;
-        case SET_APPROVAL_FOR_ALL:
+        case ERC721_SET_APPROVAL_FOR_ALL:
             msg->numScreens = 3;
             break;
         default:
@@ -87,7 +86,7 @@ static void handle_finalize(void *parameters) {
     if (!allzeroes((void *) &msg->pluginSharedRO->txContent->value,
                    sizeof(msg->pluginSharedRO->txContent->value))) {
         // Set Approval for All is not payable
-        if (context->selectorIndex == SET_APPROVAL_FOR_ALL) {
+        if (context->selectorIndex == ERC721_SET_APPROVAL_FOR_ALL) {
             msg->result = ETH_PLUGIN_RESULT_ERROR;
             return;
         } else {
@@ -114,8 +113,8 @@ static void handle_query_contract_id(void *parameters) {
     strlcpy(msg->name, "NFT", msg->nameLength);
 
     switch (context->selectorIndex) {
-        case SET_APPROVAL_FOR_ALL:
-        case APPROVE:
+        case ERC721_SET_APPROVAL_FOR_ALL:
+        case ERC721_APPROVE:
 #ifdef HAVE_NBGL
             strlcpy(msg->version, "manage", msg->versionLength);
             strlcat(msg->name, " allowance", msg->nameLength);
@@ -123,9 +122,9 @@ static void handle_query_contract_id(void *parameters) {
             strlcpy(msg->version, "Allowance", msg->versionLength);
 #endif
             break;
-        case SAFE_TRANSFER:
-        case SAFE_TRANSFER_DATA:
-        case TRANSFER:
+        case ERC721_SAFE_TRANSFER:
+        case ERC721_SAFE_TRANSFER_DATA:
+        case ERC721_TRANSFER:
             strlcpy(msg->version, "Transfer", msg->versionLength);
             break;
         default:
@@ -7,27 +7,18 @@
 #include <stdint.h>
 #include "ethUstream.h"
 #include "asset_info.h"
+#include "abi_decoder.h"
+#include "plugin_selectors.h"
 
 // Internal plugin for EIP 721: https://eips.ethereum.org/EIPS/eip-721
 
-typedef enum {
-    APPROVE,
-    SET_APPROVAL_FOR_ALL,
-    TRANSFER,
-    SAFE_TRANSFER,
-    SAFE_TRANSFER_DATA,
-    SELECTORS_COUNT
-} erc721_selector_t;
-
-typedef enum {
-    FROM,
-    TO,
-    DATA,
-    TOKEN_ID,
-    OPERATOR,
-    APPROVED,
-    NONE,
-} erc721_selector_field;
+// Position of the parameters in the ABI schema of each selector
+#define APPROVE_OPERATOR  0
+#define APPROVE_TOKEN_ID  1
+#define APPROVED_OPERATOR 0
+#define APPROVED_APPROVED 1
+#define TRANSFER_TO       1
+#define TRANSFER_TOKEN_ID 2
 
 typedef struct erc721_context_t {
     uint8_t address[ADDRESS_LENGTH];
@@ -35,7 +26,7 @@ typedef struct erc721_context_t {
 
     bool approved;
 
-    erc721_selector_field next_param;
+    abi_decoder_t decoder;
     uint8_t selectorIndex;
 } erc721_context_t;
 
@@ -4,61 +4,41 @@
 #include "plugin_utils.h"
 #include "eth_plugin_internal.h"
 
-static void handle_approve(ethPluginProvideParameter_t *msg, erc721_context_t *context) {
-    switch (context->next_param) {
-        case OPERATOR:
-            copy_address(context->address, msg->parameter, sizeof(context->address));
-            context->next_param = TOKEN_ID;
+static void handle_approve(erc721_context_t *context, const abi_event_t *event) {
+    switch (event->param) {
+        case APPROVE_OPERATOR:
+            copy_address(context->address, event->word, sizeof(context->address));
             break;
-        case TOKEN_ID:
-            copy_parameter(context->tokenId, msg->parameter, sizeof(context->tokenId));
-            context->next_param = NONE;
+        case APPROVE_TOKEN_ID:
+            copy_parameter(context->tokenId, event->word, sizeof(context->tokenId));
             break;
         default:
-            PRINTF("Unhandled parameter offset\n");
-            msg->result = ETH_PLUGIN_RESULT_ERROR;
             break;
     }
 }
 
-// `strict` will set msg->result to ERROR if parsing continues after `TOKEN_ID` has been parsed.
-static void handle_transfer(ethPluginProvideParameter_t *msg,
-                            erc721_context_t *context,
-                            bool strict) {
-    switch (context->next_param) {
-        case FROM:
-            context->next_param = TO;
-            break;
-        case TO:
-            copy_address(context->address, msg->parameter, sizeof(context->address));
-            context->next_param = TOKEN_ID;
+static void handle_transfer(erc721_context_t *context, const abi_event_t *event) {
+    switch (event->param) {
+        case TRANSFER_TO:
+            copy_address(context->address, event->word, sizeof(context->address));
             break;
-        case TOKEN_ID:
-            copy_parameter(context->tokenId, msg->parameter, sizeof(context->tokenId));
-            context->next_param = NONE;
+        case TRANSFER_TOKEN_ID:
+            copy_parameter(context->tokenId, event->word, sizeof(context->tokenId));
             break;
         default:
-            if (strict) {
-                PRINTF("Param %d not supported\n", context->next_param);
-                msg->result = ETH_PLUGIN_RESULT_ERROR;
-            }
             break;
     }
 }
 
-static void handle_approval_for_all(ethPluginProvideParameter_t *msg, erc721_context_t *context) {
-    switch (context->next_param) {
-        case OPERATOR:
-            context->next_param = APPROVED;
-            copy_address(context->address, msg->parameter, sizeof(context->address));
+static void handle_approval_for_all(erc721_context_t *context, const abi_event_t *event) {
+    switch (event->param) {
+        case APPROVED_OPERATOR:
+            copy_address(context->address, event->word, sizeof(context->address));
             break;
-        case APPROVED:
-            context->next_param = NONE;
-            context->approved = msg->parameter[PARAMETER_LENGTH - 1];
+        case APPROVED_APPROVED:
+            context->approved = event->word[PARAMETER_LENGTH - 1];
             break;
         default:
-            PRINTF("Param %d not supported\n", context->next_param);
-            msg->result = ETH_PLUGIN_RESULT_ERROR;
             break;
     }
 }
@@ -66,6 +46,7 @@ static void handle_approval_for_all(ethPluginProvideParameter_t *msg, erc721_con
 void handle_provide_parameter_721(void *parameters) {
     ethPluginProvideParameter_t *msg = (ethPluginProvideParameter_t *) parameters;
     erc721_context_t *context = (erc721_context_t *) msg->pluginContext;
+    abi_event_t event;
 
     PRINTF("erc721 plugin provide parameter %d %.*H\n",
            msg->parameterOffset,
@@ -73,20 +54,33 @@ void handle_provide_parameter_721(void *parameters) {
            msg->parameter);
 
     msg->result = ETH_PLUGIN_RESULT_SUCCESSFUL;
+    if (!abi_decoder_feed(&context->decoder,
+                          msg->parameterOffset - SELECTOR_SIZE,
+                          msg->parameter,
+                          &event)) {
+        msg->result = ETH_PLUGIN_RESULT_ERROR;
+        return;
+    }
+    if (event.type != ABI_EVENT_WORD) {
+        // Only `safeTransferFrom` with data has a dynamic parameter, which is not displayed,
+        // and may be followed by extra data.
+        if (context->selectorIndex != ERC721_SAFE_TRANSFER_DATA) {
+            PRINTF("Unhandled parameter offset\n");
+            msg->result = ETH_PLUGIN_RESULT_ERROR;
+        }
+        return;
+    }
     switch (context->selectorIndex) {
-        case APPROVE:
-            handle_approve(msg, context);
-            break;
-        case SAFE_TRANSFER:
-        case TRANSFER:
-            handle_transfer(msg, context, true);
+        case ERC721_APPROVE:
+            handle_approve(context, &event);
             break;
-        case SAFE_TRANSFER_DATA:
-            // Set `strict` to `false` because additional data might be present.
-            handle_transfer(msg, context, false);
+        case ERC721_SAFE_TRANSFER:
+        case ERC721_TRANSFER:
+        case ERC721_SAFE_TRANSFER_DATA:
+            handle_transfer(context, &event);
             break;
-        case SET_APPROVAL_FOR_ALL:
-            handle_approval_for_all(msg, context);
+        case ERC721_SET_APPROVAL_FOR_ALL:
+            handle_approval_for_all(context, &event);
             break;
         default:
             PRINTF("Selector index %d not supported\n", context->selectorIndex);
@@ -127,15 +127,15 @@ void handle_query_contract_ui_721(void *parameters) {
 
     msg->result = ETH_PLUGIN_RESULT_OK;
     switch (context->selectorIndex) {
-        case APPROVE:
+        case ERC721_APPROVE:
             set_approval_ui(msg, context);
             break;
-        case SET_APPROVAL_FOR_ALL:
+        case ERC721_SET_APPROVAL_FOR_ALL:
             set_approval_for_all_ui(msg, context);
             break;
-        case SAFE_TRANSFER_DATA:
-        case SAFE_TRANSFER:
-        case TRANSFER:
+        case ERC721_SAFE_TRANSFER_DATA:
+        case ERC721_SAFE_TRANSFER:
+        case ERC721_TRANSFER:
             set_transfer_ui(msg, context);
             break;
         default:
@@ -5,6 +5,7 @@
 #include "eth_plugin_handler.h"
 #include "shared_context.h"
 #include "common_utils.h"
+#include "abi_decoder.h"
 
 void getEth2PublicKey(uint32_t *bip32Path, uint8_t bip32PathLength, uint8_t *out);
 
@@ -19,6 +20,17 @@ void getEth2PublicKey(uint32_t *bip32Path, uint8_t bip32PathLength, uint8_t *out
 #define ETH2_WITHDRAWAL_CREDENTIALS_LENGTH 0x20
 #define ETH2_SIGNATURE_LENGTH              0x60
 
+// Position of the parameters in the ABI schema
+#define ETH2_DEPOSIT_PUBKEY         0
+#define ETH2_WITHDRAWAL_CREDENTIALS 1
+#define ETH2_SIGNATURE              2
+
+// deposit(bytes,bytes,bytes,bytes32)
+static const uint8_t ETH2_DEPOSIT_ABI[] = {ABI_TYPE_BYTES,
+                                           ABI_TYPE_BYTES,
+                                           ABI_TYPE_BYTES,
+                                           ABI_TYPE_WORD};
+
 static const uint8_t deposit_contract_address[] = {0x00, 0x00, 0x00, 0x00, 0x21, 0x9a, 0xb5,
                                                    0x40, 0x35, 0x6c, 0xbb, 0x83, 0x9c, 0xbe,
                                                    0x05, 0x30, 0x3d, 0x77, 0x05, 0xfa};
@@ -29,8 +41,39 @@ static const uint8_t deposit_contract_address[] = {0x00, 0x00, 0x00, 0x00, 0x21,
 typedef struct eth2_deposit_parameters_t {
     uint8_t valid;
     char deposit_address[ETH2_DEPOSIT_PUBKEY_LENGTH];
+    abi_decoder_t decoder;
 } eth2_deposit_parameters_t;
 
+/**
+ * Check an offset or length of the deposit against the only accepted value
+ *
+ * @param[in] event the offset or length event
+ * @return whether it matches
+ */
+static bool eth2_check_layout(const abi_event_t *event) {
+    static const uint32_t offsets[] = {ETH2_DEPOSIT_PUBKEY_OFFSET,
+                                       ETH2_WITHDRAWAL_CREDENTIALS_OFFSET,
+                                       ETH2_SIGNATURE_OFFSET};
+    static const uint32_t lengths[] = {ETH2_DEPOSIT_PUBKEY_LENGTH,
+                                       ETH2_WITHDRAWAL_CREDENTIALS_LENGTH,
+                                       ETH2_SIGNATURE_LENGTH};
+    uint32_t check;
+
+    if (event->type == ABI_EVENT_OFFSET) {
+        check = offsets[event->param];
+    } else {
+        check = lengths[event->param];
+    }
+    if (event->value != check) {
+        PRINTF("eth2 plugin parameter %d check failed, expected %d got %d\n",
+               event->param,
+               check,
+               event->value);
+        return false;
+    }
+    return true;
+}
+
 void eth2_plugin_call(int message, void *parameters) {
     switch (message) {
         case ETH_PLUGIN_INIT_CONTRACT: {
@@ -44,6 +87,7 @@ void eth2_plugin_call(int message, void *parameters) {
                 msg->result = ETH_PLUGIN_RESULT_ERROR;
             } else {
                 context->valid = 1;
+                abi_decoder_init(&context->decoder, ETH2_DEPOSIT_ABI, sizeof(ETH2_DEPOSIT_ABI));
                 msg->result = ETH_PLUGIN_RESULT_OK;
             }
         } break;
@@ -51,121 +95,81 @@ void eth2_plugin_call(int message, void *parameters) {
         case ETH_PLUGIN_PROVIDE_PARAMETER: {
             ethPluginProvideParameter_t *msg = (ethPluginProvideParameter_t *) parameters;
             eth2_deposit_parameters_t *context = (eth2_deposit_parameters_t *) msg->pluginContext;
-            uint32_t index;
+            abi_event_t event;
             PRINTF("eth2 plugin provide parameter %d %.*H\n",
                    msg->parameterOffset,
                    32,
                    msg->parameter);
-            switch (msg->parameterOffset) {
-                case 4 + (32 * 0):  // pubkey offset
-                case 4 + (32 * 1):  // withdrawal credentials offset
-                case 4 + (32 * 2):  // signature offset
-                case 4 + (32 * 4):  // deposit pubkey length
-                case 4 + (32 * 7):  // withdrawal credentials length
-                case 4 + (32 * 9):  // signature length
-                {
-                    uint32_t check = 0;
-                    switch (msg->parameterOffset) {
-                        case 4 + (32 * 0):
-                            check = ETH2_DEPOSIT_PUBKEY_OFFSET;
-                            break;
-                        case 4 + (32 * 1):
-                            check = ETH2_WITHDRAWAL_CREDENTIALS_OFFSET;
-                            break;
-                        case 4 + (32 * 2):
-                            check = ETH2_SIGNATURE_OFFSET;
-                            break;
-                        case 4 + (32 * 4):
-                            check = ETH2_DEPOSIT_PUBKEY_LENGTH;
-                            break;
-                        case 4 + (32 * 7):
-                            check = ETH2_WITHDRAWAL_CREDENTIALS_LENGTH;
-                            break;
-                        case 4 + (32 * 9):
-                            check = ETH2_SIGNATURE_LENGTH;
-                            break;
-                        default:
-                            break;
-                    }
-                    index = U4BE(msg->parameter, 32 - 4);
-                    if (index != check) {
-                        PRINTF("eth2 plugin parameter check %d failed, expected %d got %d\n",
-                               msg->parameterOffset,
-                               check,
-                               index);
+            msg->result = ETH_PLUGIN_RESULT_OK;
+            if (!abi_decoder_feed(&context->decoder,
+                                  msg->parameterOffset - SELECTOR_SIZE,
+                                  msg->parameter,
+                                  &event)) {
+                context->valid = 0;
+                break;
+            }
+            switch (event.type) {
+                case ABI_EVENT_OFFSET:
+                case ABI_EVENT_LENGTH:
+                    if (!eth2_check_layout(&event)) {
                         context->valid = 0;
                     }
-                    msg->result = ETH_PLUGIN_RESULT_OK;
-                } break;
-
-                case 4 + (32 * 5):  // deposit pubkey 1
-                {
-                    // Copy the first 32 bytes.
-                    memcpy(context->deposit_address,
-                           msg->parameter,
-                           sizeof(context->deposit_address));
-                    msg->result = ETH_PLUGIN_RESULT_OK;
                     break;
-                }
-                case 4 + (32 * 6):  // deposit pubkey 2
-                {
-                    // Copy the last 16 bytes.
-                    memcpy(context->deposit_address + 32,
-                           msg->parameter,
-                           sizeof(context->deposit_address) - 32);
-
-                    // Use a temporary buffer to store the string representation.
-                    char tmp[ETH2_DEPOSIT_PUBKEY_LENGTH];
-                    if (!getEthDisplayableAddress((uint8_t *) context->deposit_address,
-                                                  tmp,
-                                                  sizeof(tmp),
-                                                  chainConfig->chainId)) {
-                        msg->result = ETH_PLUGIN_RESULT_ERROR;
-                        return;
-                    }
 
-                    // Copy back the string to the global variable.
-                    strlcpy(context->deposit_address, tmp, ETH2_DEPOSIT_PUBKEY_LENGTH);
-                    msg->result = ETH_PLUGIN_RESULT_OK;
-                    break;
-                }
-                case 4 + (32 * 3):   // deposit data root
-                case 4 + (32 * 10):  // signature
-                case 4 + (32 * 11):
-                case 4 + (32 * 12):
-                    msg->result = ETH_PLUGIN_RESULT_OK;
+                case ABI_EVENT_BYTES_CHUNK:
+                    if ((event.param == ETH2_DEPOSIT_PUBKEY) && (event.index == 0)) {
+                        // Copy the first 32 bytes.
+                        memcpy(context->deposit_address, event.word, 32);
+                    } else if (event.param == ETH2_DEPOSIT_PUBKEY) {
+                        // Copy the last 16 bytes.
+                        memcpy(context->deposit_address + 32,
+                               event.word,
+                               sizeof(context->deposit_address) - 32);
+
+                        // Use a temporary buffer to store the string representation.
+                        char tmp[ETH2_DEPOSIT_PUBKEY_LENGTH];
+                        if (!getEthDisplayableAddress((uint8_t *) context->deposit_address,
+                                                      tmp,
+                                                      sizeof(tmp),
+                                                      chainConfig->chainId)) {
+                            msg->result = ETH_PLUGIN_RESULT_ERROR;
+                            return;
+                        }
+
+                        // Copy back the string to the global variable.
+                        strlcpy(context->deposit_address, tmp, ETH2_DEPOSIT_PUBKEY_LENGTH);
+                    } else if (event.param == ETH2_WITHDRAWAL_CREDENTIALS) {
+                        uint8_t tmp[48];
+                        uint32_t withdrawalKeyPath[4];
+                        withdrawalKeyPath[0] = WITHDRAWAL_KEY_PATH_1;
+                        withdrawalKeyPath[1] = WITHDRAWAL_KEY_PATH_2;
+                        if (eth2WithdrawalIndex > INDEX_MAX) {
+                            PRINTF("eth2 plugin: withdrawal index is too big\n");
+                            PRINTF("Got %u which is higher than INDEX_MAX (%u)\n",
+                                   eth2WithdrawalIndex,
+                                   INDEX_MAX);
+                            msg->result = ETH_PLUGIN_RESULT_ERROR;
+                            context->valid = 0;
+                        }
+                        withdrawalKeyPath[2] = eth2WithdrawalIndex;
+                        withdrawalKeyPath[3] = WITHDRAWAL_KEY_PATH_4;
+                        getEth2PublicKey(withdrawalKeyPath, 4, tmp);
+                        PRINTF("eth2 plugin computed withdrawal public key %.*H\n", 48, tmp);
+                        cx_hash_sha256(tmp, 48, tmp, 32);
+                        tmp[0] = 0;
+                        if (memcmp(tmp, event.word, 32) != 0) {
+                            PRINTF("eth2 plugin invalid withdrawal credentials\n");
+                            PRINTF("Got %.*H\n", 32, event.word);
+                            PRINTF("Expected %.*H\n", 32, tmp);
+                            msg->result = ETH_PLUGIN_RESULT_ERROR;
+                            context->valid = 0;
+                        }
+                    }
+                    // the signature is not checked
                     break;
 
-                case 4 + (32 * 8):  // withdrawal credentials
-                {
-                    uint8_t tmp[48];
-                    uint32_t withdrawalKeyPath[4];
-                    withdrawalKeyPath[0] = WITHDRAWAL_KEY_PATH_1;
-                    withdrawalKeyPath[1] = WITHDRAWAL_KEY_PATH_2;
-                    if (eth2WithdrawalIndex > INDEX_MAX) {
-                        PRINTF("eth2 plugin: withdrawal index is too big\n");
-                        PRINTF("Got %u which is higher than INDEX_MAX (%u)\n",
-                               eth2WithdrawalIndex,
-                               INDEX_MAX);
-                        msg->result = ETH_PLUGIN_RESULT_ERROR;
-                        context->valid = 0;
-                    }
-                    withdrawalKeyPath[2] = eth2WithdrawalIndex;
-                    withdrawalKeyPath[3] = WITHDRAWAL_KEY_PATH_4;
-                    getEth2PublicKey(withdrawalKeyPath, 4, tmp);
-                    PRINTF("eth2 plugin computed withdrawal public key %.*H\n", 48, tmp);
-                    cx_hash_sha256(tmp, 48, tmp, 32);
-                    tmp[0] = 0;
-                    if (memcmp(tmp, msg->parameter, 32) != 0) {
-                        PRINTF("eth2 plugin invalid withdrawal credentials\n");
-                        PRINTF("Got %.*H\n", 32, msg->parameter);
-                        PRINTF("Expected %.*H\n", 32, tmp);
-                        msg->result = ETH_PLUGIN_RESULT_ERROR;
-                        context->valid = 0;
-                    } else {
-                        msg->result = ETH_PLUGIN_RESULT_OK;
-                    }
-                } break;
+                case ABI_EVENT_WORD:  // deposit data root
+                    break;
 
                 default:
                     PRINTF("Unhandled parameter offset\n");
@@ -177,7 +181,7 @@ void eth2_plugin_call(int message, void *parameters) {
             ethPluginFinalize_t *msg = (ethPluginFinalize_t *) parameters;
             eth2_deposit_parameters_t *context = (eth2_deposit_parameters_t *) msg->pluginContext;
             PRINTF("eth2 plugin finalize\n");
-            if (context->valid) {
+            if (context->valid && abi_decoder_done(&context->decoder)) {
                 msg->numScreens = 2;
                 msg->uiType = ETH_UI_TYPE_GENERIC;
                 msg->result = ETH_PLUGIN_RESULT_OK;
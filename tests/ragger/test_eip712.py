@@ -10,13 +10,15 @@ from eth_account.messages import encode_typed_data
 import web3
 
 from ragger.backend import BackendInterface
+from ragger.error import ExceptionRAPDU
 from ragger.firmware import Firmware
 from ragger.navigator import Navigator, NavInsID
 from ragger.navigator.navigation_scenario import NavigateWithScenario
 
 import client.response_parser as ResponseParser
 from client.utils import recover_message
-from client.client import EthAppClient
+from client.client import EthAppClient, StatusWord
+from client.eip712.struct import EIP712FieldType
 from client.eip712 import InputData
 from client.settings import SettingID, settings_toggle
 
@@ -115,12 +117,16 @@ def eip712_new_common(firmware: Firmware,
                       json_data: dict,
                       filters: Optional[dict],
                       verbose: bool,
-                      golden_run: bool):
+                      golden_run: bool,
+                      batch: bool = False,
+                      manifest: bool = False):
     assert InputData.process_data(app_client,
                                   json_data,
                                   filters,
                                   partial(autonext, firmware, navigator, default_screenshot_path),
-                                  golden_run)
+                                  golden_run,
+                                  batch,
+                                  manifest)
     with app_client.eip712_sign_new(BIP32_PATH):
         moves = []
         if firmware.device.startswith("nano"):
@@ -183,6 +189,109 @@ def test_eip712_new(firmware: Firmware,
     assert recovered_addr == get_wallet_addr(app_client)
 
 
+def test_eip712_batched_impl(firmware: Firmware,
+                             backend: BackendInterface,
+                             navigator: Navigator,
+                             default_screenshot_path: Path,
+                             input_file: Path,
+                             verbose: bool):
+    app_client = EthAppClient(backend)
+    if firmware.device == "nanos":
+        pytest.skip("Not supported on LNS")
+
+    if verbose:
+        settings_toggle(firmware, navigator, [SettingID.VERBOSE_EIP712])
+
+    with open(input_file, encoding="utf-8") as file:
+        data = json.load(file)
+        vrs = eip712_new_common(firmware,
+                                navigator,
+                                default_screenshot_path,
+                                app_client,
+                                data,
+                                None,
+                                verbose,
+                                False,
+                                True)
+
+        recovered_addr = recover_message(data, vrs)
+
+    assert recovered_addr == get_wallet_addr(app_client)
+
+
+def count_round_trips(backend: BackendInterface, monkeypatch: pytest.MonkeyPatch) -> list[int]:
+    counter = [0]
+    exchange_raw = backend.exchange_raw
+    exchange_async_raw = backend.exchange_async_raw
+
+    def counted_exchange_raw(*args, **kwargs):
+        counter[0] += 1
+        return exchange_raw(*args, **kwargs)
+
+    def counted_exchange_async_raw(*args, **kwargs):
+        counter[0] += 1
+        return exchange_async_raw(*args, **kwargs)
+
+    monkeypatch.setattr(backend, "exchange_raw", counted_exchange_raw)
+    monkeypatch.setattr(backend, "exchange_async_raw", counted_exchange_async_raw)
+    return counter
+
+
+def test_eip712_batched_round_trips(firmware: Firmware,
+                                    backend: BackendInterface,
+                                    navigator: Navigator,
+                                    default_screenshot_path: Path,
+                                    monkeypatch: pytest.MonkeyPatch):
+    app_client = EthAppClient(backend)
+    if firmware.device == "nanos":
+        pytest.skip("Not supported on LNS")
+
+    with open(input_files()[0], encoding="utf-8") as file:
+        data = json.load(file)
+
+    round_trips = []
+    for batch in (False, True):
+        counter = count_round_trips(backend, monkeypatch)
+        vrs = eip712_new_common(firmware,
+                                navigator,
+                                default_screenshot_path,
+                                app_client,
+                                data,
+                                None,
+                                False,
+                                False,
+                                batch)
+        round_trips.append(counter[0])
+        monkeypatch.undo()
+        assert recover_message(data, vrs) == get_wallet_addr(app_client)
+
+    print(f"EIP-712 round trips: {round_trips[0]} unbatched, {round_trips[1]} batched")
+    assert round_trips[1] < round_trips[0]
+
+
+def test_eip712_batched_impl_after_partial(firmware: Firmware, backend: BackendInterface):
+    app_client = EthAppClient(backend)
+    if firmware.device == "nanos":
+        pytest.skip("Not supported on LNS")
+
+    with app_client.eip712_send_struct_defs({
+        "EIP712Domain": [(EIP712FieldType.STRING, "string", None, [], "name")],
+    }):
+        pass
+    with app_client.eip712_send_struct_impl_root_struct("EIP712Domain"):
+        pass
+    # only the first chunk of a value too long for a single APDU
+    chunks = app_client._cmd_builder.eip712_send_struct_impl_struct_field(bytearray(b"a" * 300))
+    assert len(chunks) > 1
+    backend.exchange_raw(chunks[0])
+
+    # a batch cannot be the continuation of that value
+    with pytest.raises(ExceptionRAPDU) as e:
+        with app_client.eip712_send_struct_impl_struct_fields([b"b"]):
+            pass
+    assert e.value.status == StatusWord.CONDITION_NOT_SATISFIED
+
+
 class DataSet():
     data: dict
     filters: dict
@@ -428,3 +537,32 @@ def test_eip712_advanced_filtering(firmware: Firmware,
     # verify signature
     addr = recover_message(data_set.data, vrs)
     assert addr == get_wallet_addr(app_client)
+
+
+def test_eip712_advanced_filtering_manifest(firmware: Firmware,
+                                            backend: BackendInterface,
+                                            navigator: Navigator,
+                                            default_screenshot_path: Path,
+                                            data_set: DataSet):
+    global SNAPS_CONFIG
+
+    app_client = EthAppClient(backend)
+    if firmware.device == "nanos":
+        pytest.skip("Not supported on LNS")
+
+    # same screens as without the manifest
+    SNAPS_CONFIG = SnapshotsConfig("test_eip712_advanced_filtering" + data_set.suffix)
+
+    vrs = eip712_new_common(firmware,
+                            navigator,
+                            default_screenshot_path,
+                            app_client,
+                            data_set.data,
+                            data_set.filters,
+                            False,
+                            False,
+                            manifest=True)
+
+    # verify signature
+    addr = recover_message(data_set.data, vrs)
+    assert addr == get_wallet_addr(app_client)
@@ -13,6 +13,8 @@ from ragger.backend import BackendInterface
 from ragger.navigator.navigation_scenario import NavigateWithScenario
 from ragger.bip import calculate_public_key_and_chaincode, CurveChoice
 
+from web3 import Web3
+
 from client.client import EthAppClient, StatusWord
 import client.response_parser as ResponseParser
 
@@ -66,6 +68,46 @@ def test_get_pk(backend: BackendInterface,
         assert chaincode.hex() == ref_chaincode
 
 
+@pytest.mark.parametrize(
+    "base_path, first_index, count",
+    [
+        ("m/44'/60'/0'/0", 0, 10),
+        ("m/44'/60'/0'", 0x80000000 + 3, 5),
+    ],
+)
+def test_get_pk_batch(backend: BackendInterface, base_path: str, first_index: int, count: int):
+    app_client = EthAppClient(backend)
+
+    entries = list()
+    responses = app_client.get_public_addrs(base_path, first_index, count)
+    for response in responses:
+        entries += ResponseParser.pk_addr_batch(response.data)
+    assert len(responses) > 1
+    assert len(entries) == count
+
+    for idx, (pk, addr) in enumerate(entries):
+        index = first_index + idx
+        if index & 0x80000000:
+            path = f"{base_path}/{index & 0x7fffffff}'"
+        else:
+            path = f"{base_path}/{index}"
+        ref_pk, _ = calculate_public_key_and_chaincode(curve=CurveChoice.Secp256k1, path=path)
+        ref_pk = bytes.fromhex(ref_pk)
+        assert pk == bytes([0x02 | (ref_pk[-1] & 1)]) + ref_pk[1:33]
+        assert addr == Web3.keccak(ref_pk[1:])[-20:]
+
+
+def test_get_pk_batch_exhausted(backend: BackendInterface):
+    app_client = EthAppClient(backend)
+
+    app_client.get_public_addrs("m/44'/60'/0'/0", 0, 1)
+    with pytest.raises(ExceptionRAPDU) as e:
+        # batch continuation (P1 = 0x03) with no remaining key
+        app_client.send_raw(0xe0, 0x02, 0x03, 0x00, bytes())
+
+    assert e.value.status == StatusWord.CONDITION_NOT_SATISFIED
+
+
 def test_get_eth2_pk(firmware: Firmware,
                      backend: BackendInterface,
                      scenario_navigator: NavigateWithScenario,
@@ -84,3 +126,19 @@ def test_get_eth2_pk(firmware: Firmware,
         pk = pk[1:49]
 
     assert pk == ref_pk
+
+
+def test_get_eth2_pk_batch(backend: BackendInterface):
+    app_client = EthAppClient(backend)
+
+    # validator keys m/12381/3600/i/0/0, for i in [2, 9)
+    keys = list()
+    responses = app_client.get_eth2_public_addrs("m/12381/3600/2/0/0", 2, 7)
+    for response in responses:
+        keys += ResponseParser.eth2_pk_batch(response.data)
+    assert len(responses) > 1
+    assert len(keys) == 7
+
+    for idx, pk in enumerate(keys):
+        path = f"m/12381/3600/{2 + idx}/0/0"
+        assert pk == bls.SkToPk(mnemonic_and_path_to_key(SPECULOS_MNEMONIC, path))
@@ -0,0 +1,15 @@
+/*
+ * Minimal host stand-in for the app's apdu_constants.h, only covering what the
+ * EIP-712 modules under test rely on.
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+#define APDU_RESPONSE_OK                      0x9000
+#define APDU_RESPONSE_INVALID_DATA            0x6a80
+#define APDU_RESPONSE_INSUFFICIENT_MEMORY     0x6a84
+#define APDU_RESPONSE_CONDITION_NOT_SATISFIED 0x6985
+
+extern uint16_t apdu_response_code;
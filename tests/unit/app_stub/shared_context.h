@@ -0,0 +1,24 @@
+/*
+ * Minimal host stand-in for the app's shared_context.h, only covering what the
+ * EIP-712 modules under test rely on.
+ */
+
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "cx.h"
+#include "common_utils.h"
+
+typedef struct messageSigningContext712_t {
+    uint8_t domainHash[32];
+    uint8_t messageHash[32];
+} messageSigningContext712_t;
+
+typedef union {
+    messageSigningContext712_t messageSigningContext712;
+} tmpCtx_t;
+
+extern tmpCtx_t tmpCtx;
+extern cx_sha3_t global_sha3;
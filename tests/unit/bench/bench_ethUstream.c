@@ -0,0 +1,63 @@
+/*
+ * Streams the transaction corpus through the RLP parser at various APDU sizes
+ * and reports the throughput and the number of Keccak update calls per
+ * transaction.
+ *
+ * usage: bench_ethUstream [iterations]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "tx_corpus.h"
+
+static const size_t g_chunk_sizes[] = {16, 64, 150, 255};
+
+static double now(void) {
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + (ts.tv_nsec / 1e9);
+}
+
+int main(int argc, char **argv) {
+    static tx_corpus_entry_t entry;
+    txContext_t context;
+    txContent_t content;
+    uint8_t hash[32];
+    unsigned long iterations = 10000;
+
+    if (argc > 1) {
+        iterations = strtoul(argv[1], NULL, 0);
+    }
+    printf("%-24s %6s %8s %14s %12s\n", "transaction", "chunk", "bytes", "bytes/s", "hash/tx");
+    for (size_t i = 0; i < tx_corpus_count(); ++i) {
+        tx_corpus_build(i, &entry);
+        for (size_t c = 0; c < sizeof(g_chunk_sizes) / sizeof(g_chunk_sizes[0]); ++c) {
+            double start;
+            double elapsed;
+            uint32_t hash_calls;
+
+            g_cx_hash_calls = 0;
+            if (!tx_corpus_parse(&entry, g_chunk_sizes[c], &context, &content, hash)) {
+                fprintf(stderr, "%s : parsing failed\n", entry.name);
+                return EXIT_FAILURE;
+            }
+            hash_calls = g_cx_hash_calls;
+
+            start = now();
+            for (unsigned long n = 0; n < iterations; ++n) {
+                tx_corpus_parse(&entry, g_chunk_sizes[c], &context, &content, hash);
+            }
+            elapsed = now() - start;
+            printf("%-24s %6zu %8zu %14.0f %12u\n",
+                   entry.name,
+                   g_chunk_sizes[c],
+                   entry.length,
+                   (entry.length * iterations) / elapsed,
+                   hash_calls);
+        }
+    }
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,68 @@
+/*
+ * Looks up the name & ticker of every network of the generated table and
+ * reports the average time per lookup, next to a linear scan of the same
+ * table for reference.
+ *
+ * usage: bench_network [iterations]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "network.h"
+#include "net_table.gen.h"
+
+static double now(void) {
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + (ts.tv_nsec / 1e9);
+}
+
+static const char *linear_lookup(const uint64_t *chain_id) {
+    for (size_t i = 0; i < NETWORK_COUNT; ++i) {
+        if (g_network_chain_ids[i] == *chain_id) {
+            return &g_network_strings[g_network_names[i]];
+        }
+    }
+    return NULL;
+}
+
+int main(int argc, char **argv) {
+    unsigned long iterations = 100000;
+    volatile size_t sink = 0;
+    double start;
+    double binary;
+    double linear;
+
+    if (argc > 1) {
+        iterations = strtoul(argv[1], NULL, 0);
+    }
+
+    start = now();
+    for (unsigned long n = 0; n < iterations; ++n) {
+        for (size_t i = 0; i < NETWORK_COUNT; ++i) {
+            sink += (size_t) get_network_name_from_chain_id(&g_network_chain_ids[i]);
+            sink += (size_t) get_network_ticker_from_chain_id(&g_network_chain_ids[i]);
+        }
+    }
+    binary = (now() - start) / (iterations * NETWORK_COUNT * 2.0);
+
+    start = now();
+    for (unsigned long n = 0; n < iterations; ++n) {
+        for (size_t i = 0; i < NETWORK_COUNT; ++i) {
+            sink += (size_t) linear_lookup(&g_network_chain_ids[i]);
+            sink += (size_t) linear_lookup(&g_network_chain_ids[i]);
+        }
+    }
+    linear = (now() - start) / (iterations * NETWORK_COUNT * 2.0);
+
+    printf("%u networks, %zu bytes of strings\n",
+           NETWORK_COUNT,
+           sizeof(g_network_strings));
+    printf("%-16s %12s\n", "lookup", "ns/lookup");
+    printf("%-16s %12.1f\n", "binary search", binary * 1e9);
+    printf("%-16s %12.1f\n", "linear scan", linear * 1e9);
+    return EXIT_SUCCESS;
+}
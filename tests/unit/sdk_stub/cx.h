@@ -0,0 +1,88 @@
+/*
+ * Minimal host stand-in for the BOLOS SDK cx.h : the Keccak primitives are
+ * implemented in software and every cx_hash_no_throw call is counted so the
+ * benchmarks can report it.
+ */
+
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+typedef uint32_t cx_err_t;
+
+#define CX_OK             0x00000000
+#define CX_INTERNAL_ERROR 0xFFFFFF85
+#define CX_LAST           (1 << 0)
+
+#define CX_CHECK(call)        \
+    do {                      \
+        error = (call);       \
+        if (error != CX_OK) { \
+            goto end;         \
+        }                     \
+    } while (0)
+
+#define CX_ASSERT(call)         \
+    do {                        \
+        if ((call) != CX_OK) {  \
+            abort();            \
+        }                       \
+    } while (0)
+
+typedef struct {
+    uint8_t algo;
+} cx_hash_t;
+
+typedef struct {
+    cx_hash_t header;
+    size_t output_size;
+    size_t block_size;
+    size_t blen;
+    uint8_t block[200];
+    uint64_t acc[25];
+} cx_sha3_t;
+
+#define CX_SHA256_SIZE 32
+
+// Keccak-256 stands in for SHA-256, the code under test only relies on the digest size
+typedef cx_sha3_t cx_sha256_t;
+
+typedef uint32_t cx_curve_t;
+
+#define CX_CURVE_256K1 0x21
+
+typedef enum {
+    CX_SHA512 = 5,
+} cx_md_t;
+
+typedef struct {
+    uint32_t curve;
+    size_t W_len;
+    uint8_t W[65];
+} cx_ecfp_public_key_t;
+
+cx_err_t cx_keccak_init_no_throw(cx_sha3_t *hash, size_t size);
+int cx_sha256_init(cx_sha256_t *hash);
+// not implemented by sdk_stub, to be mocked by the tests that need them
+cx_err_t cx_ecfp_init_public_key_no_throw(uint32_t curve,
+                                          const uint8_t *raw_key,
+                                          size_t key_len,
+                                          cx_ecfp_public_key_t *key);
+bool cx_ecdsa_verify_no_throw(const cx_ecfp_public_key_t *key,
+                              const uint8_t *hash,
+                              size_t hash_len,
+                              const uint8_t *sig,
+                              size_t sig_len);
+cx_err_t cx_hash_no_throw(cx_hash_t *hash,
+                          uint32_t mode,
+                          const uint8_t *in,
+                          size_t len,
+                          uint8_t *out,
+                          size_t out_len);
+cx_err_t cx_math_mult_no_throw(uint8_t *r, const uint8_t *a, const uint8_t *b, size_t len);
+
+// Number of cx_hash_no_throw calls since the last reset
+extern uint32_t g_cx_hash_calls;
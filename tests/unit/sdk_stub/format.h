@@ -0,0 +1,6 @@
+/*
+ * Host stand-in for lib_standard_app/format.h, nothing from it is needed by
+ * the modules under test.
+ */
+
+#pragma once
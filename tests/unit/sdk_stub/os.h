@@ -0,0 +1,67 @@
+/*
+ * Minimal host stand-in for the BOLOS SDK os.h, only covering what the
+ * parsing and arithmetic modules under test rely on.
+ */
+
+#pragma once
+
+#include <setjmp.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#if DEBUG
+#define PRINTF printf
+#else
+#define PRINTF(...)
+#endif
+
+#define UNUSED(x) (void) x
+
+#ifndef MIN
+#define MIN(x, y) ((x) < (y) ? (x) : (y))
+#endif
+#ifndef MAX
+#define MAX(x, y) ((x) > (y) ? (x) : (y))
+#endif
+
+#define PIC(x) (x)
+
+#define ARRAY_SIZE(a) (sizeof(a) / sizeof((a)[0]))
+
+#define EXCEPTION 1
+
+typedef unsigned short exception_t;
+
+typedef struct try_context_s {
+    jmp_buf jmp_buf;
+    struct try_context_s *previous;
+    exception_t ex;
+} try_context_t;
+
+extern try_context_t *G_try_last;
+
+void os_longjmp(unsigned int exception);
+
+#define THROW(x) os_longjmp(x)
+
+// No return is allowed from within a TRY block, same as with the real SDK
+#define BEGIN_TRY                                 \
+    {                                             \
+        try_context_t __try_ctx;                  \
+        __try_ctx.previous = G_try_last;          \
+        G_try_last = &__try_ctx;                  \
+        __try_ctx.ex = setjmp(__try_ctx.jmp_buf);
+
+#define TRY if (__try_ctx.ex == 0)
+
+#define CATCH_OTHER(e)                 \
+    G_try_last = __try_ctx.previous;   \
+    if (__try_ctx.ex != 0)             \
+        for (exception_t e = __try_ctx.ex, __once = 1; __once; __once = 0, (void) e)
+
+#define FINALLY
+
+#define END_TRY }
+
+size_t strlcpy(char *dst, const char *src, size_t size);
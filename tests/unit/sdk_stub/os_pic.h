@@ -0,0 +1,4 @@
+#pragma once
+
+// PIC() is provided by the os.h stub
+#include "os.h"
@@ -0,0 +1,170 @@
+/*
+ * Host implementations of the BOLOS SDK symbols declared in the stub headers.
+ */
+
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "os.h"
+#include "cx.h"
+
+try_context_t *G_try_last = NULL;
+
+uint32_t g_cx_hash_calls = 0;
+
+void os_longjmp(unsigned int exception) {
+    if (G_try_last == NULL) {
+        abort();
+    }
+    longjmp(G_try_last->jmp_buf, exception);
+}
+
+size_t strlcpy(char *dst, const char *src, size_t size) {
+    size_t len = strlen(src);
+
+    if (size > 0) {
+        size_t copy = (len >= size) ? (size - 1) : len;
+        memcpy(dst, src, copy);
+        dst[copy] = '\0';
+    }
+    return len;
+}
+
+// ethereum-plugin-sdk's helper, kept here so its common_utils.c does not have to be built
+uint64_t u64_from_BE(const uint8_t *in, uint8_t size) {
+    uint64_t res = 0;
+
+    for (uint8_t i = 0; i < size; ++i) {
+        res = (res << 8) | in[i];
+    }
+    return res;
+}
+
+static const uint64_t keccak_round_constants[24] = {
+    0x0000000000000001, 0x0000000000008082, 0x800000000000808a, 0x8000000080008000,
+    0x000000000000808b, 0x0000000080000001, 0x8000000080008081, 0x8000000000008009,
+    0x000000000000008a, 0x0000000000000088, 0x0000000080008009, 0x000000008000000a,
+    0x000000008000808b, 0x800000000000008b, 0x8000000000008089, 0x8000000000008003,
+    0x8000000000008002, 0x8000000000000080, 0x000000000000800a, 0x800000008000000a,
+    0x8000000080008081, 0x8000000000008080, 0x0000000080000001, 0x8000000080008008};
+
+static const uint8_t keccak_rotations[24] = {1,  3,  6,  10, 15, 21, 28, 36, 45, 55, 2,  14,
+                                             27, 41, 56, 8,  25, 43, 62, 18, 39, 61, 20, 44};
+
+static const uint8_t keccak_pi_lanes[24] = {10, 7,  11, 17, 18, 3, 5,  16, 8,  21, 24, 4,
+                                            15, 23, 19, 13, 12, 2, 20, 14, 22, 9,  6,  1};
+
+#define ROTL64(x, y) (((x) << (y)) | ((x) >> (64 - (y))))
+
+static void keccak_f1600(uint64_t st[25]) {
+    uint64_t bc[5];
+    uint64_t t;
+
+    for (int round = 0; round < 24; ++round) {
+        // Theta
+        for (int i = 0; i < 5; ++i) {
+            bc[i] = st[i] ^ st[i + 5] ^ st[i + 10] ^ st[i + 15] ^ st[i + 20];
+        }
+        for (int i = 0; i < 5; ++i) {
+            t = bc[(i + 4) % 5] ^ ROTL64(bc[(i + 1) % 5], 1);
+            for (int j = 0; j < 25; j += 5) {
+                st[j + i] ^= t;
+            }
+        }
+        // Rho Pi
+        t = st[1];
+        for (int i = 0; i < 24; ++i) {
+            int j = keccak_pi_lanes[i];
+            bc[0] = st[j];
+            st[j] = ROTL64(t, keccak_rotations[i]);
+            t = bc[0];
+        }
+        // Chi
+        for (int j = 0; j < 25; j += 5) {
+            for (int i = 0; i < 5; ++i) {
+                bc[i] = st[j + i];
+            }
+            for (int i = 0; i < 5; ++i) {
+                st[j + i] ^= (~bc[(i + 1) % 5]) & bc[(i + 2) % 5];
+            }
+        }
+        // Iota
+        st[0] ^= keccak_round_constants[round];
+    }
+}
+
+static void keccak_absorb_block(cx_sha3_t *hash) {
+    for (size_t i = 0; i < (hash->block_size / 8); ++i) {
+        uint64_t lane = 0;
+        for (int b = 7; b >= 0; --b) {
+            lane = (lane << 8) | hash->block[i * 8 + b];
+        }
+        hash->acc[i] ^= lane;
+    }
+    keccak_f1600(hash->acc);
+    hash->blen = 0;
+}
+
+cx_err_t cx_keccak_init_no_throw(cx_sha3_t *hash, size_t size) {
+    memset(hash, 0, sizeof(*hash));
+    hash->output_size = size / 8;
+    hash->block_size = 200 - 2 * hash->output_size;
+    return CX_OK;
+}
+
+cx_err_t cx_hash_no_throw(cx_hash_t *hash,
+                          uint32_t mode,
+                          const uint8_t *in,
+                          size_t len,
+                          uint8_t *out,
+                          size_t out_len) {
+    cx_sha3_t *ctx = (cx_sha3_t *) hash;
+
+    g_cx_hash_calls += 1;
+    while (len > 0) {
+        size_t chunk = MIN(len, ctx->block_size - ctx->blen);
+        memcpy(ctx->block + ctx->blen, in, chunk);
+        ctx->blen += chunk;
+        in += chunk;
+        len -= chunk;
+        if (ctx->blen == ctx->block_size) {
+            keccak_absorb_block(ctx);
+        }
+    }
+    if (mode & CX_LAST) {
+        if (out_len < ctx->output_size) {
+            return !CX_OK;
+        }
+        // Keccak padding (pre-FIPS202), 0x01 ... 0x80
+        memset(ctx->block + ctx->blen, 0, ctx->block_size - ctx->blen);
+        ctx->block[ctx->blen] ^= 0x01;
+        ctx->block[ctx->block_size - 1] ^= 0x80;
+        keccak_absorb_block(ctx);
+        for (size_t i = 0; i < ctx->output_size; ++i) {
+            out[i] = (uint8_t) (ctx->acc[i / 8] >> (8 * (i % 8)));
+        }
+    }
+    return CX_OK;
+}
+
+int cx_sha256_init(cx_sha256_t *hash) {
+    return cx_keccak_init_no_throw(hash, 256);
+}
+
+// Big-endian schoolbook multiplication, r is 2 * len bytes long
+cx_err_t cx_math_mult_no_throw(uint8_t *r, const uint8_t *a, const uint8_t *b, size_t len) {
+    memset(r, 0, 2 * len);
+    for (size_t i = 0; i < len; ++i) {
+        uint32_t carry = 0;
+        uint8_t ai = a[len - 1 - i];
+        for (size_t j = 0; j < len; ++j) {
+            size_t pos = 2 * len - 1 - (i + j);
+            uint32_t acc = r[pos] + (uint32_t) ai * b[len - 1 - j] + carry;
+            r[pos] = (uint8_t) acc;
+            carry = acc >> 8;
+        }
+        r[len - 1 - i] = (uint8_t) carry;
+    }
+    return CX_OK;
+}
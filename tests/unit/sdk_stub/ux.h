@@ -0,0 +1,6 @@
+/*
+ * Empty host stand-in for the BOLOS SDK ux.h, the modules under test only include it through
+ * their UI headers.
+ */
+
+#pragma once
@@ -0,0 +1,228 @@
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <cmocka.h>
+
+#include <string.h>
+
+#include "abi_decoder.h"
+
+#define MAX_WORDS 16
+
+typedef struct {
+    uint8_t words[MAX_WORDS][ABI_WORD_SIZE];
+    uint8_t count;
+} calldata_t;
+
+static void push_u32(calldata_t *calldata, uint32_t value) {
+    uint8_t *word = calldata->words[calldata->count++];
+
+    memset(word, 0, ABI_WORD_SIZE);
+    word[28] = value >> 24;
+    word[29] = value >> 16;
+    word[30] = value >> 8;
+    word[31] = value;
+}
+
+static void push_fill(calldata_t *calldata, uint8_t fill) {
+    memset(calldata->words[calldata->count++], fill, ABI_WORD_SIZE);
+}
+
+// safeBatchTransferFrom(address,address,uint256[],uint256[],bytes)
+static const uint8_t batch_schema[] =
+    {ABI_TYPE_WORD, ABI_TYPE_WORD, ABI_TYPE_ARRAY, ABI_TYPE_ARRAY, ABI_TYPE_BYTES};
+
+static void batch_calldata(calldata_t *calldata) {
+    calldata->count = 0;
+    push_fill(calldata, 0x11);    // from
+    push_fill(calldata, 0x22);    // to
+    push_u32(calldata, 5 * 32);   // ids offset
+    push_u32(calldata, 8 * 32);   // values offset
+    push_u32(calldata, 11 * 32);  // data offset
+    push_u32(calldata, 2);        // ids length
+    push_u32(calldata, 7);
+    push_u32(calldata, 8);
+    push_u32(calldata, 2);  // values length
+    push_u32(calldata, 100);
+    push_u32(calldata, 200);
+    push_u32(calldata, 33);  // data length
+    push_fill(calldata, 0xaa);
+    push_fill(calldata, 0xbb);
+}
+
+static void test_static_only(void **state) {
+    (void) state;
+    static const uint8_t schema[] = {ABI_TYPE_WORD, ABI_TYPE_WORD};
+    abi_decoder_t decoder;
+    abi_event_t event;
+    calldata_t calldata = {0};
+
+    push_fill(&calldata, 0x01);
+    push_fill(&calldata, 0x02);
+    push_fill(&calldata, 0x03);
+    assert_true(abi_decoder_init(&decoder, schema, sizeof(schema)));
+    for (uint8_t i = 0; i < 2; ++i) {
+        assert_true(abi_decoder_feed(&decoder, i * ABI_WORD_SIZE, calldata.words[i], &event));
+        assert_int_equal(event.type, ABI_EVENT_WORD);
+        assert_int_equal(event.param, i);
+        assert_true(event.word == calldata.words[i]);
+    }
+    assert_true(abi_decoder_done(&decoder));
+    assert_true(abi_decoder_feed(&decoder, 2 * ABI_WORD_SIZE, calldata.words[2], &event));
+    assert_int_equal(event.type, ABI_EVENT_TRAILING);
+}
+
+static void test_batch_transfer(void **state) {
+    (void) state;
+    static const struct {
+        abi_event_type_t type;
+        uint8_t param;
+        uint16_t index;
+        uint32_t value;
+    } expected[] = {
+        {ABI_EVENT_WORD, 0, 0, 0},
+        {ABI_EVENT_WORD, 1, 0, 0},
+        {ABI_EVENT_OFFSET, 2, 0, 5 * 32},
+        {ABI_EVENT_OFFSET, 3, 0, 8 * 32},
+        {ABI_EVENT_OFFSET, 4, 0, 11 * 32},
+        {ABI_EVENT_LENGTH, 2, 0, 2},
+        {ABI_EVENT_ELEMENT, 2, 0, 0},
+        {ABI_EVENT_ELEMENT, 2, 1, 0},
+        {ABI_EVENT_LENGTH, 3, 0, 2},
+        {ABI_EVENT_ELEMENT, 3, 0, 0},
+        {ABI_EVENT_ELEMENT, 3, 1, 0},
+        {ABI_EVENT_LENGTH, 4, 0, 33},
+        {ABI_EVENT_BYTES_CHUNK, 4, 0, 32},
+        {ABI_EVENT_BYTES_CHUNK, 4, 1, 1},
+    };
+    abi_decoder_t decoder;
+    abi_event_t event;
+    calldata_t calldata;
+
+    batch_calldata(&calldata);
+    assert_int_equal(calldata.count, sizeof(expected) / sizeof(expected[0]));
+    assert_true(abi_decoder_init(&decoder, batch_schema, sizeof(batch_schema)));
+    for (uint8_t i = 0; i < calldata.count; ++i) {
+        assert_false(abi_decoder_done(&decoder));
+        assert_true(abi_decoder_feed(&decoder, i * ABI_WORD_SIZE, calldata.words[i], &event));
+        assert_int_equal(event.type, expected[i].type);
+        assert_int_equal(event.param, expected[i].param);
+        assert_int_equal(event.index, expected[i].index);
+        assert_int_equal(event.value, expected[i].value);
+    }
+    assert_true(abi_decoder_done(&decoder));
+}
+
+static void test_tails_out_of_order(void **state) {
+    (void) state;
+    static const uint8_t schema[] = {ABI_TYPE_ARRAY, ABI_TYPE_ARRAY};
+    abi_decoder_t decoder;
+    abi_event_t event;
+    calldata_t calldata = {0};
+
+    push_u32(&calldata, 4 * 32);
+    push_u32(&calldata, 2 * 32);
+    push_u32(&calldata, 1);  // second array
+    push_u32(&calldata, 42);
+    push_u32(&calldata, 0);  // first array, empty
+    assert_true(abi_decoder_init(&decoder, schema, sizeof(schema)));
+    for (uint8_t i = 0; i < calldata.count; ++i) {
+        assert_true(abi_decoder_feed(&decoder, i * ABI_WORD_SIZE, calldata.words[i], &event));
+    }
+    assert_int_equal(event.type, ABI_EVENT_LENGTH);
+    assert_int_equal(event.param, 0);
+    assert_true(abi_decoder_done(&decoder));
+}
+
+static void test_truncated(void **state) {
+    (void) state;
+    // transfer(address,uint256)
+    static const uint8_t transfer_schema[] = {ABI_TYPE_WORD, ABI_TYPE_WORD};
+    abi_decoder_t decoder;
+    abi_event_t event;
+    calldata_t calldata = {0};
+
+    // no parameters at all
+    assert_true(abi_decoder_init(&decoder, transfer_schema, sizeof(transfer_schema)));
+    assert_false(abi_decoder_done(&decoder));
+
+    // missing static parameter
+    assert_true(abi_decoder_init(&decoder, transfer_schema, sizeof(transfer_schema)));
+    push_fill(&calldata, 0x11);
+    assert_true(abi_decoder_feed(&decoder, 0, calldata.words[0], &event));
+    assert_false(abi_decoder_done(&decoder));
+
+    // cut anywhere before the end of the last tail, be it in the heads, before a tail or in
+    // the middle of one
+    batch_calldata(&calldata);
+    for (uint8_t length = 0; length < calldata.count; ++length) {
+        assert_true(abi_decoder_init(&decoder, batch_schema, sizeof(batch_schema)));
+        for (uint8_t i = 0; i < length; ++i) {
+            assert_true(abi_decoder_feed(&decoder, i * ABI_WORD_SIZE, calldata.words[i], &event));
+        }
+        assert_false(abi_decoder_done(&decoder));
+    }
+}
+
+static void test_invalid(void **state) {
+    (void) state;
+    abi_decoder_t decoder;
+    abi_event_t event;
+    calldata_t calldata;
+
+    // words have to be fed in order
+    batch_calldata(&calldata);
+    assert_true(abi_decoder_init(&decoder, batch_schema, sizeof(batch_schema)));
+    assert_false(abi_decoder_feed(&decoder, ABI_WORD_SIZE, calldata.words[1], &event));
+
+    // unaligned offset
+    batch_calldata(&calldata);
+    calldata.words[2][31] += 1;
+    assert_true(abi_decoder_init(&decoder, batch_schema, sizeof(batch_schema)));
+    assert_true(abi_decoder_feed(&decoder, 0, calldata.words[0], &event));
+    assert_true(abi_decoder_feed(&decoder, 32, calldata.words[1], &event));
+    assert_false(abi_decoder_feed(&decoder, 64, calldata.words[2], &event));
+
+    // offset pointing into the heads
+    batch_calldata(&calldata);
+    calldata.words[3][31] = 32;
+    calldata.words[3][30] = 0;
+    assert_true(abi_decoder_init(&decoder, batch_schema, sizeof(batch_schema)));
+    for (uint8_t i = 0; i < 3; ++i) {
+        assert_true(abi_decoder_feed(&decoder, i * ABI_WORD_SIZE, calldata.words[i], &event));
+    }
+    assert_false(abi_decoder_feed(&decoder, 3 * ABI_WORD_SIZE, calldata.words[3], &event));
+
+    // gap between two tails
+    batch_calldata(&calldata);
+    calldata.words[3][31] += 32;
+    assert_true(abi_decoder_init(&decoder, batch_schema, sizeof(batch_schema)));
+    for (uint8_t i = 0; i < 8; ++i) {
+        assert_true(abi_decoder_feed(&decoder, i * ABI_WORD_SIZE, calldata.words[i], &event));
+    }
+    assert_false(abi_decoder_feed(&decoder, 8 * ABI_WORD_SIZE, calldata.words[8], &event));
+
+    // length too big
+    batch_calldata(&calldata);
+    calldata.words[5][0] = 1;
+    assert_true(abi_decoder_init(&decoder, batch_schema, sizeof(batch_schema)));
+    for (uint8_t i = 0; i < 5; ++i) {
+        assert_true(abi_decoder_feed(&decoder, i * ABI_WORD_SIZE, calldata.words[i], &event));
+    }
+    assert_false(abi_decoder_feed(&decoder, 5 * ABI_WORD_SIZE, calldata.words[5], &event));
+
+    // too many parameters
+    assert_false(abi_decoder_init(&decoder, batch_schema, ABI_MAX_PARAMS + 1));
+}
+
+int main() {
+    const struct CMUnitTest tests[] = {
+        cmocka_unit_test(test_static_only),
+        cmocka_unit_test(test_batch_transfer),
+        cmocka_unit_test(test_tails_out_of_order),
+        cmocka_unit_test(test_truncated),
+        cmocka_unit_test(test_invalid),
+    };
+
+    return cmocka_run_group_tests(tests, NULL, NULL);
+}
@@ -0,0 +1,157 @@
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <cmocka.h>
+
+#include <string.h>
+
+#include "manage_asset_info.h"
+
+tmpCtx_t tmpCtx;
+
+// provide an asset whose contract address is filled with the given byte
+static int provide(uint8_t id, uint64_t chain_id) {
+    extraInfo_t *asset = reserve_asset_slot();
+
+    memset(asset->token.address, id, ADDRESS_LENGTH);
+    validate_current_asset_info(chain_id);
+    return tmpCtx.transactionContext.currentAssetIndex;
+}
+
+static int lookup(uint8_t id, uint64_t chain_id) {
+    uint8_t addr[ADDRESS_LENGTH];
+
+    memset(addr, id, sizeof(addr));
+    return get_asset_index_by_addr(addr, chain_id);
+}
+
+// the ranks of the set entries must be a permutation of [0, count)
+static void assert_ranks_contiguous(void) {
+    uint8_t count = get_known_assets_count();
+    bool seen[MAX_ASSETS] = {false};
+
+    for (int i = 0; i < (int) MAX_ASSETS; i++) {
+        if (asset_info_is_set(i)) {
+            uint8_t rank = tmpCtx.transactionContext.assetEntries[i].rank;
+
+            assert_true(rank < count);
+            assert_false(seen[rank]);
+            seen[rank] = true;
+        }
+    }
+}
+
+static int setup(void **state) {
+    (void) state;
+    forget_known_assets();
+    return 0;
+}
+
+static void test_eviction_order(void **state) {
+    (void) state;
+
+    for (uint8_t id = 1; id <= MAX_ASSETS; id++) {
+        assert_int_equal(provide(id, 1), id - 1);
+    }
+    assert_int_equal(get_known_assets_count(), MAX_ASSETS);
+    // the oldest one becomes the most recently used
+    assert_int_equal(lookup(1, 1), 0);
+    assert_ranks_contiguous();
+    // so the second oldest one gets evicted, then the third one
+    assert_int_equal(provide(0x80, 1), 1);
+    assert_int_equal(lookup(2, 1), -1);
+    assert_int_equal(provide(0x81, 1), 2);
+    assert_int_equal(lookup(3, 1), -1);
+    assert_int_equal(lookup(1, 1), 0);
+    assert_int_equal(lookup(0x80, 1), 1);
+    assert_int_equal(get_known_assets_count(), MAX_ASSETS);
+    assert_ranks_contiguous();
+}
+
+static void test_reprovide(void **state) {
+    (void) state;
+
+    assert_int_equal(provide(1, 1), 0);
+    assert_int_equal(provide(2, 1), 1);
+    assert_int_equal(provide(3, 1), 2);
+    // the older copy is dropped, lookups stay unambiguous
+    assert_int_equal(provide(2, 1), 3);
+    assert_int_equal(get_known_assets_count(), 3);
+    assert_int_equal(lookup(2, 1), 3);
+    assert_ranks_contiguous();
+    // the same address on another chain is another asset
+    assert_int_equal(provide(2, 5), 1);
+    assert_int_equal(get_known_assets_count(), 4);
+    assert_int_equal(lookup(2, 1), 3);
+    assert_int_equal(lookup(2, 5), 1);
+    assert_ranks_contiguous();
+}
+
+static void test_third_chain(void **state) {
+    (void) state;
+
+    provide(1, 1);
+    provide(2, 2);
+    provide(3, 1);
+    provide(4, 2);
+    // chain 1 becomes the most recently used one
+    assert_int_equal(lookup(1, 1), 0);
+    assert_int_equal(lookup(4, 2), 3);
+    // then chain 2, so the assets of chain 1 make room for chain 3
+    provide(5, 3);
+    assert_int_equal(get_known_assets_count(), 3);
+    assert_int_equal(lookup(1, 1), -1);
+    assert_int_equal(lookup(3, 1), -1);
+    assert_true(lookup(2, 2) >= 0);
+    assert_true(lookup(4, 2) >= 0);
+    assert_true(lookup(5, 3) >= 0);
+    assert_ranks_contiguous();
+    // chain 3 becomes the least recently used one
+    assert_true(lookup(4, 2) >= 0);
+    provide(6, 1);
+    assert_int_equal(lookup(5, 3), -1);
+    assert_true(lookup(6, 1) >= 0);
+    assert_int_equal(get_known_assets_count(), 3);
+    assert_ranks_contiguous();
+}
+
+static void test_any_chain(void **state) {
+    (void) state;
+
+    assert_int_equal(provide(1, 1), 0);
+    assert_int_equal(provide(2, 137), 1);
+    assert_int_equal(lookup(1, 0), 0);
+    assert_int_equal(lookup(2, 0), 1);
+    assert_int_equal(lookup(1, 137), -1);
+    assert_int_equal(lookup(2, 1), -1);
+    assert_int_equal(lookup(3, 0), -1);
+}
+
+static void test_rejected_provide(void **state) {
+    (void) state;
+
+    for (uint8_t id = 1; id <= MAX_ASSETS; id++) {
+        provide(id, 1);
+    }
+    // reserved but never validated, the evicted asset is gone anyway
+    assert_ptr_equal(reserve_asset_slot(), &tmpCtx.transactionContext.extraInfo[0]);
+    assert_int_equal(lookup(1, 1), -1);
+    assert_int_equal(get_known_assets_count(), MAX_ASSETS - 1);
+    assert_ranks_contiguous();
+    // and its slot is the next one used
+    assert_int_equal(provide(0x80, 1), 0);
+    assert_int_equal(get_known_assets_count(), MAX_ASSETS);
+    assert_ranks_contiguous();
+}
+
+int main() {
+    const struct CMUnitTest tests[] = {
+        cmocka_unit_test_setup(test_eviction_order, setup),
+        cmocka_unit_test_setup(test_reprovide, setup),
+        cmocka_unit_test_setup(test_third_chain, setup),
+        cmocka_unit_test_setup(test_any_chain, setup),
+        cmocka_unit_test_setup(test_rejected_provide, setup),
+    };
+
+    return cmocka_run_group_tests(tests, NULL, NULL);
+}
@@ -0,0 +1,153 @@
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <cmocka.h>
+
+#include <stdio.h>
+#include <string.h>
+
+#include "derived_key_cache.h"
+#include "crypto_helpers.h"
+
+// paths starting with it fail to be derived
+#define FAILING_PURPOSE 0xdead
+
+static uint32_t g_derivations;
+static uint32_t g_checksums;
+
+// the public key is made out of the last path level, so that keys differ from one path to another
+cx_err_t bip32_derive_get_pubkey_256(cx_curve_t curve,
+                                     const uint32_t *path,
+                                     size_t path_len,
+                                     uint8_t raw_pubkey[static 65],
+                                     uint8_t *chain_code,
+                                     cx_md_t hashID) {
+    (void) curve;
+    (void) hashID;
+    g_derivations += 1;
+    if (path[0] == FAILING_PURPOSE) {
+        return 0x1234;
+    }
+    memset(raw_pubkey, path[path_len - 1], 65);
+    raw_pubkey[0] = 0x04;
+    memset(chain_code, 0xcc, 32);
+    return CX_OK;
+}
+
+void getEthAddressFromRawKey(const uint8_t raw_pubkey[static 65],
+                             uint8_t out[static ADDRESS_LENGTH]) {
+    memcpy(out, &raw_pubkey[1], ADDRESS_LENGTH);
+}
+
+// stands in for the checksummed address, depends on the key & the chain ID
+void getEthAddressStringFromRawKey(const uint8_t raw_pubkey[static 65],
+                                   char out[static ADDRESS_LENGTH * 2],
+                                   uint64_t chainId) {
+    g_checksums += 1;
+    snprintf(out, ADDRESS_LENGTH * 2 + 1, "%02x:%llu", raw_pubkey[1], (unsigned long long) chainId);
+}
+
+static const derived_key_t *get(const uint32_t *path, uint8_t path_length, uint64_t chain_id) {
+    return get_derived_key(path, path_length, chain_id);
+}
+
+static void test_path_hit(void **state) {
+    (void) state;
+    const uint32_t path[] = {0x8000002c, 0x8000003c, 0x80000000, 0, 1};
+    const uint32_t other_path[] = {0x8000002c, 0x8000003c, 0x80000000, 0, 2};
+    const derived_key_t *key;
+    uint32_t derivations = g_derivations;
+
+    assert_non_null(key = get(path, 5, 1));
+    assert_int_equal(g_derivations, derivations + 1);
+    assert_int_equal(key->address[0], 1);
+    assert_string_equal(key->address_str, "01:1");
+    assert_int_equal(key->chain_code[0], 0xcc);
+    // same path, no derivation
+    assert_ptr_equal(get(path, 5, 1), key);
+    assert_int_equal(g_derivations, derivations + 1);
+    // a prefix of it is another path
+    assert_non_null(key = get(path, 4, 1));
+    assert_int_equal(key->address[0], 0);
+    assert_int_equal(g_derivations, derivations + 2);
+    assert_non_null(key = get(other_path, 5, 1));
+    assert_int_equal(key->address[0], 2);
+    assert_int_equal(g_derivations, derivations + 3);
+    // all still cached
+    assert_int_equal(get(path, 5, 1)->address[0], 1);
+    assert_int_equal(get(path, 4, 1)->address[0], 0);
+    assert_int_equal(g_derivations, derivations + 3);
+}
+
+static void test_chain_id_change(void **state) {
+    (void) state;
+    const uint32_t path[] = {0x8000002c, 0x8000003c, 0x80000000, 0, 3};
+    const derived_key_t *key;
+    uint32_t derivations = g_derivations;
+    uint32_t checksums = g_checksums;
+
+    assert_non_null(key = get(path, 5, 1));
+    assert_string_equal(key->address_str, "03:1");
+    assert_int_equal(g_checksums, checksums + 1);
+    // only the checksum gets recomputed
+    assert_ptr_equal(get(path, 5, 137), key);
+    assert_string_equal(key->address_str, "03:137");
+    assert_int_equal(key->address[0], 3);
+    assert_int_equal(g_checksums, checksums + 2);
+    // and only when the chain ID differs from the last one
+    assert_ptr_equal(get(path, 5, 137), key);
+    assert_int_equal(g_checksums, checksums + 2);
+    assert_ptr_equal(get(path, 5, 1), key);
+    assert_string_equal(key->address_str, "03:1");
+    assert_int_equal(g_checksums, checksums + 3);
+    assert_int_equal(g_derivations, derivations + 1);
+}
+
+static void test_invalid(void **state) {
+    (void) state;
+    const uint32_t path[] = {FAILING_PURPOSE, 0x8000003c};
+    uint32_t derivations = g_derivations;
+
+    assert_null(get(path, 0, 1));
+    assert_null(get(path, MAX_BIP32_PATH + 1, 1));
+    assert_int_equal(g_derivations, derivations);
+    // a failed derivation does not get cached
+    assert_null(get(path, 2, 1));
+    assert_null(get(path, 2, 1));
+    assert_int_equal(g_derivations, derivations + 2);
+}
+
+static void test_round_robin_eviction(void **state) {
+    (void) state;
+    uint32_t path[] = {0x8000002c, 0x8000003c, 0x80000000, 0, 0x10};
+    uint32_t derivations = g_derivations;
+
+    // fill the whole cache, the previous entries all get evicted
+    for (uint8_t i = 0; i < DERIVED_KEY_CACHE_SIZE; ++i) {
+        path[4] = 0x10 + i;
+        assert_non_null(get(path, 5, 1));
+    }
+    assert_int_equal(g_derivations, derivations + DERIVED_KEY_CACHE_SIZE);
+    path[4] = 0x20;
+    assert_non_null(get(path, 5, 1));
+    // the oldest one made room for it, the others are still there
+    for (uint8_t i = 1; i < DERIVED_KEY_CACHE_SIZE; ++i) {
+        path[4] = 0x10 + i;
+        assert_int_equal(get(path, 5, 1)->address[0], 0x10 + i);
+    }
+    assert_int_equal(g_derivations, derivations + DERIVED_KEY_CACHE_SIZE + 1);
+    path[4] = 0x10;
+    assert_non_null(get(path, 5, 1));
+    assert_int_equal(g_derivations, derivations + DERIVED_KEY_CACHE_SIZE + 2);
+}
+
+int main() {
+    const struct CMUnitTest tests[] = {
+        cmocka_unit_test(test_path_hit),
+        cmocka_unit_test(test_chain_id_change),
+        cmocka_unit_test(test_invalid),
+        cmocka_unit_test(test_round_robin_eviction),
+    };
+
+    return cmocka_run_group_tests(tests, NULL, NULL);
+}
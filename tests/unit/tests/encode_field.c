@@ -0,0 +1,175 @@
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <cmocka.h>
+
+#include <string.h>
+
+#include "encode_field.h"
+#include "cx.h"
+
+uint16_t apdu_response_code;
+
+static cx_sha3_t g_hash_ctx;
+
+// stands in for the hash of the current path depth
+void path_hash_nbytes(const uint8_t *data, uint8_t length) {
+    assert_int_equal(cx_hash_no_throw((cx_hash_t *) &g_hash_ctx, 0, data, length, NULL, 0), CX_OK);
+}
+
+static void hash_start(void) {
+    cx_keccak_init_no_throw(&g_hash_ctx, 256);
+}
+
+static void hash_end(uint8_t digest[32]) {
+    assert_int_equal(cx_hash_no_throw((cx_hash_t *) &g_hash_ctx, CX_LAST, NULL, 0, digest, 32),
+                     CX_OK);
+}
+
+// how values used to be encoded, into a padded 32-byte buffer hashed afterwards
+static void reference_digest(const uint8_t *value,
+                             uint8_t length,
+                             bool left_padded,
+                             uint8_t pval,
+                             uint8_t digest[32]) {
+    uint8_t padded[EIP_712_ENCODED_FIELD_LENGTH];
+
+    if (left_padded) {
+        memset(padded, pval, sizeof(padded) - length);
+        memcpy(&padded[sizeof(padded) - length], value, length);
+    } else {
+        memcpy(padded, value, length);
+        memset(&padded[length], 0x00, sizeof(padded) - length);
+    }
+    hash_start();
+    path_hash_nbytes(padded, sizeof(padded));
+    hash_end(digest);
+}
+
+static void make_value(uint8_t *value, uint8_t length, uint8_t first) {
+    for (uint8_t i = 0; i < length; ++i) {
+        value[i] = first + i;
+    }
+}
+
+static void test_uint(void **state) {
+    (void) state;
+    static const uint8_t lengths[] = {1, 8, 17, 31, 32};
+    uint8_t value[32];
+    uint8_t digest[32];
+    uint8_t expected[32];
+
+    for (size_t i = 0; i < sizeof(lengths); ++i) {
+        make_value(value, lengths[i], 0x81);
+        hash_start();
+        assert_true(encode_uint(value, lengths[i]));
+        hash_end(digest);
+        reference_digest(value, lengths[i], true, 0x00, expected);
+        assert_memory_equal(digest, expected, sizeof(digest));
+    }
+}
+
+static void test_int(void **state) {
+    (void) state;
+    uint8_t value[32];
+    uint8_t digest[32];
+    uint8_t expected[32];
+
+    // negative int64, sign-extended with 0xFF
+    make_value(value, 8, 0xf0);
+    hash_start();
+    assert_true(encode_int(value, 8, 8));
+    hash_end(digest);
+    reference_digest(value, 8, true, 0xff, expected);
+    assert_memory_equal(digest, expected, sizeof(digest));
+
+    // negative int256, no padding at all
+    make_value(value, 32, 0x80);
+    hash_start();
+    assert_true(encode_int(value, 32, 32));
+    hash_end(digest);
+    reference_digest(value, 32, true, 0xff, expected);
+    assert_memory_equal(digest, expected, sizeof(digest));
+
+    // positive int64
+    make_value(value, 8, 0x10);
+    hash_start();
+    assert_true(encode_int(value, 8, 8));
+    hash_end(digest);
+    reference_digest(value, 8, true, 0x00, expected);
+    assert_memory_equal(digest, expected, sizeof(digest));
+
+    // packed value shorter than its type, so positive whatever its first bit
+    make_value(value, 3, 0xf0);
+    hash_start();
+    assert_true(encode_int(value, 3, 8));
+    hash_end(digest);
+    reference_digest(value, 3, true, 0x00, expected);
+    assert_memory_equal(digest, expected, sizeof(digest));
+
+    assert_false(encode_int(value, 0, 8));
+}
+
+static void test_address(void **state) {
+    (void) state;
+    uint8_t value[20];
+    uint8_t digest[32];
+    uint8_t expected[32];
+
+    make_value(value, sizeof(value), 0xde);
+    hash_start();
+    assert_true(encode_address(value, sizeof(value)));
+    hash_end(digest);
+    reference_digest(value, sizeof(value), true, 0x00, expected);
+    assert_memory_equal(digest, expected, sizeof(digest));
+
+    assert_false(encode_address(value, sizeof(value) - 1));
+}
+
+static void test_bytes(void **state) {
+    (void) state;
+    static const uint8_t lengths[] = {1, 4, 20, 32};
+    uint8_t value[32];
+    uint8_t digest[32];
+    uint8_t expected[32];
+
+    for (size_t i = 0; i < sizeof(lengths); ++i) {
+        make_value(value, lengths[i], 0xa0);
+        hash_start();
+        assert_true(encode_bytes(value, lengths[i]));
+        hash_end(digest);
+        reference_digest(value, lengths[i], false, 0x00, expected);
+        assert_memory_equal(digest, expected, sizeof(digest));
+    }
+    assert_false(encode_bytes(value, 33));
+}
+
+static void test_boolean(void **state) {
+    (void) state;
+    const bool values[] = {false, true};
+    uint8_t digest[32];
+    uint8_t expected[32];
+
+    for (size_t i = 0; i < (sizeof(values) / sizeof(values[0])); ++i) {
+        uint8_t raw = values[i];
+
+        hash_start();
+        assert_true(encode_boolean(&values[i], 1));
+        hash_end(digest);
+        reference_digest(&raw, 1, true, 0x00, expected);
+        assert_memory_equal(digest, expected, sizeof(digest));
+    }
+    assert_false(encode_boolean(&values[1], 2));
+}
+
+int main() {
+    const struct CMUnitTest tests[] = {
+        cmocka_unit_test(test_uint),
+        cmocka_unit_test(test_int),
+        cmocka_unit_test(test_address),
+        cmocka_unit_test(test_bytes),
+        cmocka_unit_test(test_boolean),
+    };
+
+    return cmocka_run_group_tests(tests, NULL, NULL);
+}
@@ -0,0 +1,68 @@
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <cmocka.h>
+
+#include "tx_corpus.h"
+
+static const size_t g_chunk_sizes[] = {1, 2, 3, 5, 17, 64, 150, 255};
+
+static void reference_hash(const tx_corpus_entry_t *entry, uint8_t hash[32]) {
+    cx_sha3_t sha3;
+
+    cx_keccak_init_no_throw(&sha3, 256);
+    cx_hash_no_throw((cx_hash_t *) &sha3, CX_LAST, entry->buffer, entry->length, hash, 32);
+}
+
+static void check_content(const tx_corpus_entry_t *entry, const txContent_t *content) {
+    assert_int_equal(u64_from_BE(content->nonce.value, content->nonce.length), entry->nonce);
+    assert_int_equal(u64_from_BE(content->value.value, content->value.length), entry->value);
+    assert_int_equal(content->destinationLength, sizeof(entry->to));
+    assert_memory_equal(content->destination, entry->to, sizeof(entry->to));
+    if (entry->type == LEGACY) {
+        assert_int_equal(u64_from_BE(content->v, content->vLength), entry->chain_id);
+    } else {
+        assert_int_equal(u64_from_BE(content->chainID.value, content->chainID.length),
+                         entry->chain_id);
+    }
+}
+
+static void test_corpus_all_chunk_sizes(void **state) {
+    (void) state;
+    tx_corpus_entry_t entry;
+    txContext_t context;
+    txContent_t content;
+    uint8_t expected[32];
+    uint8_t hash[32];
+
+    for (size_t i = 0; i < tx_corpus_count(); ++i) {
+        tx_corpus_build(i, &entry);
+        reference_hash(&entry, expected);
+        for (size_t c = 0; c < sizeof(g_chunk_sizes) / sizeof(g_chunk_sizes[0]); ++c) {
+            assert_true(tx_corpus_parse(&entry, g_chunk_sizes[c], &context, &content, hash));
+            check_content(&entry, &content);
+            assert_memory_equal(hash, expected, sizeof(hash));
+        }
+    }
+}
+
+static void test_invalid_rlp_header(void **state) {
+    (void) state;
+    tx_corpus_entry_t entry;
+    txContext_t context;
+    txContent_t content;
+    uint8_t hash[32];
+
+    // first field of a legacy transaction announcing a length wider than 32 bits
+    tx_corpus_build(0, &entry);
+    entry.buffer[1] = 0xbc;
+    assert_false(tx_corpus_parse(&entry, 255, &context, &content, hash));
+}
+
+int main(void) {
+    const struct CMUnitTest tests[] = {
+        cmocka_unit_test(test_corpus_all_chunk_sizes),
+        cmocka_unit_test(test_invalid_rlp_header),
+    };
+    return cmocka_run_group_tests(tests, NULL, NULL);
+}
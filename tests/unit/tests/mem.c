@@ -0,0 +1,101 @@
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <cmocka.h>
+
+#include <stdint.h>
+
+#include "mem.h"
+
+static int setup(void **state) {
+    (void) state;
+    mem_init();
+    mem_reset_stats();
+    return 0;
+}
+
+static void test_alloc_dealloc(void **state) {
+    (void) state;
+    uint8_t *first;
+    uint8_t *second;
+
+    first = mem_alloc(10);
+    second = mem_alloc(20);
+    assert_non_null(first);
+    assert_true(second == (first + 10));
+    mem_dealloc(20);
+    assert_true(mem_alloc(0) == second);
+    assert_null(mem_alloc(mem_get_stats()->size));
+}
+
+static void test_mark_release(void **state) {
+    (void) state;
+    size_t mark;
+    uint8_t *top;
+
+    assert_non_null(mem_alloc(3));
+    mark = mem_mark();
+    top = mem_alloc(0);
+    assert_non_null(mem_alloc(100));
+    assert_non_null(mem_alloc_and_align(8, 8));
+    mem_release_to(mark);
+    assert_int_equal(mem_mark(), mark);
+    assert_true(mem_alloc(0) == top);
+
+    // a mark above the current position has no effect
+    mem_release_to(mark + 10);
+    assert_int_equal(mem_mark(), mark);
+}
+
+static void test_align(void **state) {
+    (void) state;
+    uint8_t *ptr;
+
+    assert_non_null(mem_alloc(1));
+    ptr = mem_alloc_and_align(sizeof(uint32_t), __alignof__(uint32_t));
+    assert_non_null(ptr);
+    assert_int_equal((uintptr_t) ptr % __alignof__(uint32_t), 0);
+    assert_true(mem_alloc(0) == (ptr + sizeof(uint32_t)));
+    assert_null(mem_alloc_and_align(mem_get_stats()->size, 4));
+}
+
+static void test_stats(void **state) {
+    (void) state;
+    const s_mem_stats *stats;
+    e_mem_tag tag;
+
+    tag = mem_set_tag(MEM_TAG_EIP712_TYPED_DATA);
+    assert_int_equal(tag, MEM_TAG_OTHER);
+    assert_non_null(mem_alloc(100));
+    mem_set_tag(MEM_TAG_EIP712_PATH);
+    assert_non_null(mem_alloc(50));
+    mem_dealloc(50);
+    assert_non_null(mem_alloc(20));
+    mem_set_tag(tag);
+
+    stats = mem_get_stats();
+    assert_int_equal(stats->used, 120);
+    assert_int_equal(stats->peak, 150);
+    assert_int_equal(stats->peak_tag, MEM_TAG_EIP712_PATH);
+    assert_int_equal(stats->allocated[MEM_TAG_EIP712_TYPED_DATA], 100);
+    assert_int_equal(stats->allocated[MEM_TAG_EIP712_PATH], 70);
+    assert_int_equal(stats->allocated[MEM_TAG_OTHER], 0);
+
+    // the peak survives a reset of the buffer, until the statistics are reset
+    mem_reset();
+    assert_int_equal(mem_get_stats()->peak, 150);
+    mem_reset_stats();
+    assert_int_equal(mem_get_stats()->peak, 0);
+    assert_int_equal(mem_get_stats()->allocated[MEM_TAG_EIP712_TYPED_DATA], 0);
+}
+
+int main() {
+    const struct CMUnitTest tests[] = {
+        cmocka_unit_test_setup(test_alloc_dealloc, setup),
+        cmocka_unit_test_setup(test_mark_release, setup),
+        cmocka_unit_test_setup(test_align, setup),
+        cmocka_unit_test_setup(test_stats, setup),
+    };
+
+    return cmocka_run_group_tests(tests, NULL, NULL);
+}
@@ -0,0 +1,64 @@
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <cmocka.h>
+
+#include <string.h>
+
+#include "network.h"
+#include "net_table.gen.h"
+
+static void test_table_sorted(void **state) {
+    (void) state;
+
+    for (size_t i = 1; i < NETWORK_COUNT; ++i) {
+        assert_true(g_network_chain_ids[i - 1] < g_network_chain_ids[i]);
+    }
+}
+
+static void test_every_chain_id(void **state) {
+    (void) state;
+
+    for (size_t i = 0; i < NETWORK_COUNT; ++i) {
+        const uint64_t chain_id = g_network_chain_ids[i];
+
+        assert_true(get_network_name_from_chain_id(&chain_id) ==
+                    &g_network_strings[g_network_names[i]]);
+        assert_true(get_network_ticker_from_chain_id(&chain_id) ==
+                    &g_network_strings[g_network_tickers[i]]);
+        assert_true(chain_is_ethereum_compatible(&chain_id));
+    }
+}
+
+static void test_known_networks(void **state) {
+    (void) state;
+    const uint64_t mainnet = 1;
+    const uint64_t palm = 11297108109;
+
+    assert_string_equal(get_network_name_from_chain_id(&mainnet), "Ethereum");
+    assert_string_equal(get_network_ticker_from_chain_id(&mainnet), "ETH");
+    assert_string_equal(get_network_name_from_chain_id(&palm), "Palm Network");
+    assert_string_equal(get_network_ticker_from_chain_id(&palm), "PALM");
+}
+
+static void test_unknown_networks(void **state) {
+    (void) state;
+    const uint64_t unknown[] = {0, 2, g_network_chain_ids[NETWORK_COUNT - 1] + 1, UINT64_MAX};
+
+    for (size_t i = 0; i < sizeof(unknown) / sizeof(unknown[0]); ++i) {
+        assert_null(get_network_name_from_chain_id(&unknown[i]));
+        assert_null(get_network_ticker_from_chain_id(&unknown[i]));
+        assert_false(chain_is_ethereum_compatible(&unknown[i]));
+    }
+}
+
+int main(void) {
+    const struct CMUnitTest tests[] = {
+        cmocka_unit_test(test_table_sorted),
+        cmocka_unit_test(test_every_chain_id),
+        cmocka_unit_test(test_known_networks),
+        cmocka_unit_test(test_unknown_networks),
+    };
+
+    return cmocka_run_group_tests(tests, NULL, NULL);
+}
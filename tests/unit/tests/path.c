@@ -0,0 +1,366 @@
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <cmocka.h>
+
+#include <stdio.h>
+#include <string.h>
+
+#include "os.h"  // ARRAY_SIZE
+#include "cx.h"
+#include "eip712_schema.h"
+#include "mem.h"
+#include "path.h"
+#include "typed_data.h"
+#include "type_hash.h"
+
+typedef struct {
+    // sizes given to the arrays, in turn
+    const uint8_t *array_sizes;
+    uint8_t array_sizes_count;
+    uint8_t arrays_sent;
+    uint8_t values_sent;
+    // hashing contexts the encoding needs at the current point of the message
+    uint8_t hash_depth;
+    uint8_t max_hash_depth;
+    // dotted path of the current field, as the filters expect it
+    char path[MAX_PATH_DEPTH * (UINT8_MAX + 1)];
+    size_t path_length;
+    // values sent while the path string was too long to be kept
+    uint8_t long_paths;
+} s_sender;
+
+static s_sender sender;
+
+static void keccak_init(cx_sha3_t *ctx) {
+    assert_int_equal(cx_keccak_init_no_throw(ctx, 256), CX_OK);
+}
+
+static void keccak_update(cx_sha3_t *ctx, const uint8_t *data, size_t length) {
+    assert_int_equal(cx_hash_no_throw((cx_hash_t *) ctx, 0, data, length, NULL, 0), CX_OK);
+}
+
+static void keccak_final(cx_sha3_t *ctx, uint8_t *hash) {
+    assert_int_equal(cx_hash_no_throw((cx_hash_t *) ctx, CX_LAST, NULL, 0, hash, 32), CX_OK);
+}
+
+/**
+ * Check the path string of the current field, and its hash, against the path kept on the side
+ */
+static void check_path_str(void) {
+    const char *str;
+    uint8_t length;
+    uint8_t hash[32];
+    uint8_t expected[32];
+    cx_sha3_t ctx;
+
+    str = path_get_str(&length);
+    if (sender.path_length > MAX_PATH_STR) {
+        assert_null(str);
+        sender.long_paths += 1;
+    } else {
+        assert_non_null(str);
+        assert_int_equal(length, sender.path_length);
+        assert_memory_equal(str, sender.path, length);
+    }
+    keccak_init(&ctx);
+    path_hash_str((cx_hash_t *) &ctx);
+    keccak_final(&ctx, hash);
+    eip712_keccak(sender.path, sender.path_length, expected);
+    assert_memory_equal(hash, expected, sizeof(hash));
+}
+
+/**
+ * Append a field to the path kept on the side
+ *
+ * @param[in] field_ptr the field
+ * @return the path length before it
+ */
+static size_t path_push_field(const uint8_t *field_ptr) {
+    size_t length = sender.path_length;
+    const char *key;
+    uint8_t key_length;
+    uint8_t lvls_count = 0;
+
+    if (length > 0) {
+        sender.path[sender.path_length++] = '.';
+    }
+    key = get_struct_field_keyname(field_ptr, &key_length);
+    memcpy(&sender.path[sender.path_length], key, key_length);
+    sender.path_length += key_length;
+    if (struct_field_is_array(field_ptr)) {
+        get_struct_field_array_lvls_array(field_ptr, &lvls_count);
+    }
+    for (uint8_t lvl = 0; lvl < lvls_count; ++lvl) {
+        memcpy(&sender.path[sender.path_length], ".[]", 3);
+        sender.path_length += 3;
+    }
+    return length;
+}
+
+static void send_struct(const uint8_t *struct_ptr, uint8_t *encoded);
+
+/**
+ * Send a field value the way the client does, and encode it on the side in one go
+ *
+ * @param[in] field_ptr the field
+ * @param[in] lvl index of the array level the value is at
+ * @param[out] encoded the value encoding, as it goes in the encoding of its struct
+ */
+static void send_value(const uint8_t *field_ptr, uint8_t lvl, uint8_t *encoded) {
+    uint8_t lvls_count = 0;
+    uint8_t size;
+    uint8_t item[32];
+    cx_sha3_t ctx;
+    size_t path_length = sender.path_length;
+
+    if (lvl == 0) {
+        path_length = path_push_field(field_ptr);
+    }
+    if (struct_field_is_array(field_ptr)) {
+        get_struct_field_array_lvls_array(field_ptr, &lvls_count);
+    }
+    if (lvl < lvls_count) {
+        size = sender.array_sizes[sender.arrays_sent++ % sender.array_sizes_count];
+        assert_true(path_new_array_depth(&size, sizeof(size)));
+        keccak_init(&ctx);
+        sender.hash_depth += 1;
+        for (uint8_t idx = 0; idx < size; ++idx) {
+            send_value(field_ptr, lvl + 1, item);
+            keccak_update(&ctx, item, sizeof(item));
+        }
+        sender.hash_depth -= 1;
+        keccak_final(&ctx, encoded);
+    } else if (struct_field_type(field_ptr) == TYPE_CUSTOM) {
+        send_struct(get_struct_field_custom_struct(field_ptr), encoded);
+    } else {
+        assert_ptr_equal(path_get_field(), field_ptr);
+        check_path_str();
+        memset(encoded, 0, 32);
+        encoded[0] = sender.values_sent;
+        encoded[31] = ~sender.values_sent;
+        sender.values_sent += 1;
+        if (sender.hash_depth > sender.max_hash_depth) {
+            sender.max_hash_depth = sender.hash_depth;
+        }
+        path_hash_nbytes(encoded, 32);
+        path_advance(true);
+    }
+    sender.path_length = path_length;
+}
+
+/**
+ * Send the values of a struct, and compute its hashStruct on the side
+ *
+ * @param[in] struct_ptr the struct
+ * @param[out] encoded its hashStruct
+ */
+static void send_struct(const uint8_t *struct_ptr, uint8_t *encoded) {
+    const char *name;
+    uint8_t name_length;
+    const uint8_t *field_ptr;
+    uint8_t fields_count;
+    uint8_t item[32];
+    cx_sha3_t ctx;
+
+    name = get_struct_name(struct_ptr, &name_length);
+    assert_true(type_hash(name, name_length, item));
+    keccak_init(&ctx);
+    keccak_update(&ctx, item, sizeof(item));
+    sender.hash_depth += 1;
+    field_ptr = get_struct_fields_array(struct_ptr, &fields_count);
+    for (uint8_t idx = 0; idx < fields_count; ++idx) {
+        send_value(field_ptr, 0, item);
+        keccak_update(&ctx, item, sizeof(item));
+        field_ptr = get_next_struct_field(field_ptr);
+    }
+    sender.hash_depth -= 1;
+    keccak_final(&ctx, encoded);
+}
+
+/**
+ * Send a whole message, and check its hash against the one computed on the side
+ *
+ * @param[in] root name of the message struct
+ */
+static void send_message(const char *root) {
+    uint8_t expected[32];
+
+    sender.hash_depth = 0;
+    sender.max_hash_depth = 0;
+    sender.path_length = 0;
+    assert_true(path_set_root(root, strlen(root)));
+    send_struct(get_structn(root, strlen(root)), expected);
+    assert_int_equal(path_get_depth_count(), 0);
+    assert_memory_equal(eip712_schema_message_hash(), expected, sizeof(expected));
+}
+
+static void define_struct(const char *name, const char *const (*fields)[2], size_t count) {
+    assert_true(eip712_schema_struct(name));
+    for (size_t idx = 0; idx < count; ++idx) {
+        assert_true(eip712_schema_field(fields[idx][0], fields[idx][1]));
+    }
+}
+
+static int setup(void **state) {
+    (void) state;
+    eip712_schema_init();
+    memset(&sender, 0, sizeof(sender));
+    return 0;
+}
+
+static int teardown(void **state) {
+    (void) state;
+    eip712_schema_deinit();
+    return 0;
+}
+
+// depths get suspended with partial blocks of every length, a full one included
+static void test_hash_depths(void **state) {
+    (void) state;
+    // with its type hash, a Keccak block (136 bytes) ends within the fifth field
+    static const char *const wide[][2] = {
+        {"uint256", "a"},
+        {"Leaf", "leaf"},
+        {"uint256", "b"},
+        {"uint256", "c"},
+        {"uint256", "d"},
+        {"Leaf[]", "leaves"},
+        {"bytes32", "e"},
+    };
+    // 17 words hashed before the nested struct, exactly 4 blocks
+    static const char *const full[][2] = {
+        {"uint256[]", "words"}, {"uint256", "w1"},  {"uint256", "w2"},  {"uint256", "w3"},
+        {"uint256", "w4"},      {"uint256", "w5"},  {"uint256", "w6"},  {"uint256", "w7"},
+        {"uint256", "w8"},      {"uint256", "w9"},  {"uint256", "w10"}, {"uint256", "w11"},
+        {"uint256", "w12"},     {"uint256", "w13"}, {"uint256", "w14"}, {"uint256", "w15"},
+        {"Wide", "wide"},       {"uint8", "end"},
+    };
+    static const char *const leaf[][2] = {
+        {"address", "owner"},
+        {"bool[]", "flags"},
+        {"uint256[][]", "grid"},
+    };
+    static const char *const message[][2] = {
+        {"Wide[]", "wides"},
+        {"Full", "full"},
+        {"Leaf[][]", "forest"},
+        {"int64", "tail"},
+    };
+    static const uint8_t sizes[] = {2, 3, 0, 1, 2};
+
+    define_struct("Message", message, ARRAY_SIZE(message));
+    define_struct("Wide", wide, ARRAY_SIZE(wide));
+    define_struct("Full", full, ARRAY_SIZE(full));
+    define_struct("Leaf", leaf, ARRAY_SIZE(leaf));
+    sender.array_sizes = sizes;
+    sender.array_sizes_count = ARRAY_SIZE(sizes);
+    send_message("Message");
+}
+
+// every array level is empty
+static void test_empty_arrays(void **state) {
+    (void) state;
+    static const char *const inner[][2] = {
+        {"uint256", "value"},
+    };
+    static const char *const message[][2] = {
+        {"Inner[]", "inners"},
+        {"uint256[]", "values"},
+        {"Inner", "inner"},
+        {"Inner[][]", "grid"},
+    };
+    static const uint8_t sizes[] = {0};
+
+    define_struct("Message", message, ARRAY_SIZE(message));
+    define_struct("Inner", inner, ARRAY_SIZE(inner));
+    sender.array_sizes = sizes;
+    sender.array_sizes_count = ARRAY_SIZE(sizes);
+    send_message("Message");
+}
+
+// as deep as the path goes, half of it through arrays of structs
+static void test_deep_nesting(void **state) {
+    (void) state;
+    char names[MAX_PATH_DEPTH][16];
+    char types[MAX_PATH_DEPTH][16];
+    const char *fields[2][2] = {{NULL, "next"}, {"uint256", "value"}};
+    static const uint8_t sizes[] = {1};
+    const s_mem_stats *stats = mem_get_stats();
+    uint16_t used;
+    size_t needed_before;
+
+    for (uint8_t idx = 0; idx < MAX_PATH_DEPTH; ++idx) {
+        snprintf(names[idx], sizeof(names[idx]), "Depth%u", idx);
+    }
+    for (uint8_t idx = 0; idx < MAX_PATH_DEPTH; ++idx) {
+        if ((idx + 1) == MAX_PATH_DEPTH) {
+            define_struct(names[idx], &fields[1], 1);
+        } else {
+            snprintf(types[idx],
+                     sizeof(types[idx]),
+                     (idx < MAX_ARRAY_DEPTH) ? "Depth%u[]" : "Depth%u",
+                     idx + 1);
+            fields[0][0] = types[idx];
+            define_struct(names[idx], (const char *const (*)[2]) fields, ARRAY_SIZE(fields));
+        }
+    }
+    sender.array_sizes = sizes;
+    sender.array_sizes_count = ARRAY_SIZE(sizes);
+
+    // everything but the hashing contexts, which are only allocated along the way
+    assert_true(typed_data_build_index());
+    assert_true(type_hash_init());
+    used = stats->used;
+    mem_reset_stats();
+    send_message(names[0]);
+    assert_int_equal(sender.max_hash_depth, MAX_PATH_DEPTH + MAX_ARRAY_DEPTH);
+
+    // with a full Keccak context per suspended depth, as it used to be, it would not have fit
+    needed_before = used + (sender.max_hash_depth - 1) * sizeof(cx_sha3_t);
+    assert_true(needed_before > stats->size);
+    // now they only keep their Keccak state & partial block (at most 136 bytes with Keccak-256)
+    assert_true(stats->peak <= stats->size);
+    assert_true(stats->peak <= used + (sender.max_hash_depth - 1) *
+                                          (sizeof(((cx_sha3_t *) NULL)->acc) + 136 + 1));
+}
+
+// the path string outgrows its buffer, and gets back within it
+static void test_long_path_str(void **state) {
+    (void) state;
+    static const char *const message[][2] = {
+        {"uint256", "first"},
+        {"Outer[]", "outer_structs_with_a_rather_long_name"},
+        {"uint256", "last"},
+    };
+    static const char *const outer[][2] = {
+        {"Inner", "inner_struct_with_an_even_longer_name_than_the_outer_one"},
+        {"uint256[]", "value"},
+        {"Inner[][]", "grid"},
+    };
+    static const char *const inner[][2] = {
+        {"uint256", "short"},
+        {"address[]", "addresses_with_a_name_long_enough_to_go_past_the_limit"},
+        {"bool", "flag"},
+    };
+    static const uint8_t sizes[] = {2, 1, 3};
+
+    define_struct("Message", message, ARRAY_SIZE(message));
+    define_struct("Outer", outer, ARRAY_SIZE(outer));
+    define_struct("Inner", inner, ARRAY_SIZE(inner));
+    sender.array_sizes = sizes;
+    sender.array_sizes_count = ARRAY_SIZE(sizes);
+    send_message("Message");
+    assert_int_not_equal(sender.long_paths, 0);
+}
+
+int main() {
+    const struct CMUnitTest tests[] = {
+        cmocka_unit_test_setup_teardown(test_hash_depths, setup, teardown),
+        cmocka_unit_test_setup_teardown(test_empty_arrays, setup, teardown),
+        cmocka_unit_test_setup_teardown(test_deep_nesting, setup, teardown),
+        cmocka_unit_test_setup_teardown(test_long_path_str, setup, teardown),
+    };
+
+    return cmocka_run_group_tests(tests, NULL, NULL);
+}
@@ -0,0 +1,116 @@
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <cmocka.h>
+
+#include <string.h>
+
+#include "plugin_batch.h"
+
+#define MAX_PARAMS 64
+
+// records what a plugin would receive
+typedef struct {
+    uint32_t offsets[MAX_PARAMS];
+    uint8_t count;
+    uint8_t calls;
+    uint8_t batches;
+} plugin_log_t;
+
+/**
+ * Feed the parameters of a data field to a plugin, split in chunks like the APDUs would be,
+ * the same way the transaction parser does
+ */
+static void feed(bool supported, uint32_t params_count, uint32_t chunk_size, plugin_log_t *log) {
+    uint32_t field_left = params_count * PLUGIN_PARAMETER_SIZE;
+    uint32_t field_index = 0;
+    uint32_t field_offset = 0;
+
+    memset(log, 0, sizeof(*log));
+    while (field_left > 0) {
+        uint32_t available = (field_left < chunk_size) ? field_left : chunk_size;
+
+        while (available > 0) {
+            uint8_t count = plugin_batch_count(supported, field_offset, available, field_left);
+
+            if (count > 0) {
+                for (uint8_t i = 0; i < count; ++i) {
+                    log->offsets[log->count++] = plugin_parameter_offset(field_index) + i * 32;
+                }
+                log->calls += 1;
+                log->batches += 1;
+                field_index += count;
+                available -= count * PLUGIN_PARAMETER_SIZE;
+                field_left -= count * PLUGIN_PARAMETER_SIZE;
+            } else {
+                uint32_t copy = PLUGIN_PARAMETER_SIZE - field_offset;
+
+                copy = (available < copy) ? available : copy;
+                available -= copy;
+                field_left -= copy;
+                field_offset += copy;
+                if (field_offset == PLUGIN_PARAMETER_SIZE) {
+                    log->offsets[log->count++] = plugin_parameter_offset(field_index++);
+                    log->calls += 1;
+                    field_offset = 0;
+                }
+            }
+        }
+    }
+}
+
+static void check_offsets(const plugin_log_t *log, uint32_t params_count) {
+    assert_int_equal(log->count, params_count);
+    for (uint32_t i = 0; i < params_count; ++i) {
+        assert_int_equal(log->offsets[i], 4 + i * 32);
+    }
+}
+
+static void test_batched_offsets(void **state) {
+    (void) state;
+    plugin_log_t log;
+
+    // aligned chunks
+    feed(true, 12, 8 * 32, &log);
+    check_offsets(&log, 12);
+    assert_int_equal(log.calls, 2);
+    assert_int_equal(log.batches, 2);
+
+    // chunks cutting parameters, the straddling ones being given one by one
+    feed(true, 12, 150, &log);
+    check_offsets(&log, 12);
+    assert_true(log.batches > 0);
+    assert_true(log.calls < 12);
+}
+
+static void test_fallback(void **state) {
+    (void) state;
+    plugin_log_t log;
+
+    // plugin built against an interface version without batches
+    feed(false, 12, 8 * 32, &log);
+    check_offsets(&log, 12);
+    assert_int_equal(log.calls, 12);
+    assert_int_equal(log.batches, 0);
+
+    // no batch of a single parameter
+    feed(true, 3, 32, &log);
+    check_offsets(&log, 3);
+    assert_int_equal(log.batches, 0);
+
+    // next parameter partially received
+    assert_int_equal(plugin_batch_count(true, 1, 4 * 32, 4 * 32), 0);
+    // limited by what is left of the data field
+    assert_int_equal(plugin_batch_count(true, 0, 4 * 32, 3 * 32 + 10), 3);
+    // limited by the chunk
+    assert_int_equal(plugin_batch_count(true, 0, 2 * 32 + 31, 8 * 32), 2);
+}
+
+int main() {
+    const struct CMUnitTest tests[] = {
+        cmocka_unit_test(test_batched_offsets),
+        cmocka_unit_test(test_fallback),
+    };
+
+    return cmocka_run_group_tests(tests, NULL, NULL);
+}
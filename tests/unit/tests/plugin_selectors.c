@@ -0,0 +1,97 @@
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <cmocka.h>
+
+#include "plugin_selectors.h"
+
+static void to_bytes(uint32_t value, uint8_t selector[4]) {
+    selector[0] = value >> 24;
+    selector[1] = value >> 16;
+    selector[2] = value >> 8;
+    selector[3] = value;
+}
+
+static void test_table_sorted(void **state) {
+    (void) state;
+
+    for (size_t i = 1; i < g_plugin_selectors_count; ++i) {
+        const plugin_selector_t *prev = &g_plugin_selectors[i - 1];
+        const plugin_selector_t *cur = &g_plugin_selectors[i];
+
+        assert_true((prev->selector < cur->selector) ||
+                    ((prev->selector == cur->selector) && (prev->plugin != cur->plugin)));
+    }
+}
+
+static void test_every_selector(void **state) {
+    (void) state;
+    uint8_t selector[4];
+
+    for (size_t i = 0; i < g_plugin_selectors_count; ++i) {
+        to_bytes(g_plugin_selectors[i].selector, selector);
+        assert_true(plugin_selector_find(selector, g_plugin_selectors[i].plugin) ==
+                    &g_plugin_selectors[i]);
+    }
+}
+
+static void test_shared_selectors(void **state) {
+    (void) state;
+    const uint8_t approve[] = {0x09, 0x5e, 0xa7, 0xb3};
+    const uint8_t set_approval_for_all[] = {0xa2, 0x2c, 0xb4, 0x65};
+    const plugin_selector_t *match;
+
+    match = plugin_selector_find(approve, INTERNAL_PLUGIN_ERC20);
+    assert_non_null(match);
+    assert_int_equal(match->index, ERC20_APPROVE);
+    match = plugin_selector_find(approve, INTERNAL_PLUGIN_ERC721);
+    assert_non_null(match);
+    assert_int_equal(match->index, ERC721_APPROVE);
+    assert_null(plugin_selector_find(approve, INTERNAL_PLUGIN_ERC1155));
+
+    match = plugin_selector_find(set_approval_for_all, INTERNAL_PLUGIN_ERC1155);
+    assert_non_null(match);
+    assert_int_equal(match->index, ERC1155_SET_APPROVAL_FOR_ALL);
+    assert_null(plugin_selector_find(set_approval_for_all, INTERNAL_PLUGIN_ERC20));
+}
+
+static void test_unknown_selectors(void **state) {
+    (void) state;
+    const uint8_t unknown[][4] = {
+        {0x00, 0x00, 0x00, 0x00},
+        {0x09, 0x5e, 0xa7, 0xb4},
+        {0xff, 0xff, 0xff, 0xff},
+    };
+
+    for (size_t i = 0; i < (sizeof(unknown) / sizeof(unknown[0])); ++i) {
+        for (uint8_t plugin = INTERNAL_PLUGIN_ERC20; plugin <= INTERNAL_PLUGIN_ERC1155; ++plugin) {
+            assert_null(plugin_selector_find(unknown[i], plugin));
+        }
+    }
+}
+
+static void test_hits(void **state) {
+    (void) state;
+    const uint8_t transfer[] = {0xa9, 0x05, 0x9c, 0xbb};
+    const plugin_selector_t *match = plugin_selector_find(transfer, INTERNAL_PLUGIN_ERC20);
+    size_t index = match - g_plugin_selectors;
+    uint16_t hits = get_plugin_selector_hits()[index];
+
+    plugin_selector_find(transfer, INTERNAL_PLUGIN_ERC20);
+    plugin_selector_find(transfer, INTERNAL_PLUGIN_ERC721);
+    assert_int_equal(get_plugin_selector_hits()[index], hits + 1);
+    reset_plugin_selector_hits();
+    assert_int_equal(get_plugin_selector_hits()[index], 0);
+}
+
+int main() {
+    const struct CMUnitTest tests[] = {
+        cmocka_unit_test(test_table_sorted),
+        cmocka_unit_test(test_every_selector),
+        cmocka_unit_test(test_shared_selectors),
+        cmocka_unit_test(test_unknown_selectors),
+        cmocka_unit_test(test_hits),
+    };
+
+    return cmocka_run_group_tests(tests, NULL, NULL);
+}
@@ -0,0 +1,132 @@
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <cmocka.h>
+
+#include <string.h>
+
+#include "sig_cache.h"
+#include "cx.h"
+
+#define KEY_LEN 65
+
+static uint32_t g_verify_calls;
+
+cx_err_t cx_ecfp_init_public_key_no_throw(uint32_t curve,
+                                          const uint8_t *raw_key,
+                                          size_t key_len,
+                                          cx_ecfp_public_key_t *key) {
+    key->curve = curve;
+    key->W_len = key_len;
+    memcpy(key->W, raw_key, key_len);
+    return CX_OK;
+}
+
+// the signature is "valid" if it is the first hash byte followed by the first key byte
+bool cx_ecdsa_verify_no_throw(const cx_ecfp_public_key_t *key,
+                              const uint8_t *hash,
+                              size_t hash_len,
+                              const uint8_t *sig,
+                              size_t sig_len) {
+    (void) hash_len;
+    g_verify_calls += 1;
+    return (sig_len == 2) && (sig[0] == hash[0]) && (sig[1] == key->W[0]);
+}
+
+static void make_key(uint8_t key[KEY_LEN], uint8_t id) {
+    memset(key, 0x04, KEY_LEN);
+    key[0] = id;
+}
+
+static void make_hash(uint8_t hash[CX_SHA256_SIZE], uint8_t id) {
+    memset(hash, 0x5a, CX_SHA256_SIZE);
+    hash[0] = id;
+}
+
+// verify & return whether the ECDSA verification had to be done
+static bool verify(const uint8_t *key, const uint8_t *hash, bool *valid) {
+    uint32_t calls = g_verify_calls;
+    uint8_t sig[2] = {hash[0], key[0]};
+
+    *valid = sig_cache_verify(key, KEY_LEN, hash, CX_SHA256_SIZE, sig, sizeof(sig));
+    return g_verify_calls != calls;
+}
+
+static void test_insert_and_hit(void **state) {
+    (void) state;
+    uint8_t key[KEY_LEN];
+    uint8_t hash[CX_SHA256_SIZE];
+    uint8_t bad_sig[2] = {0};
+    bool valid;
+
+    sig_cache_reset_stats();
+    make_key(key, 1);
+    make_hash(hash, 0x10);
+    // an invalid signature does not get cached
+    assert_false(sig_cache_verify(key, KEY_LEN, hash, sizeof(hash), bad_sig, sizeof(bad_sig)));
+    assert_true(verify(key, hash, &valid));
+    assert_true(valid);
+    assert_false(verify(key, hash, &valid));
+    assert_true(valid);
+    assert_int_equal(sig_cache_get_stats()->hits, 1);
+    assert_int_equal(sig_cache_get_stats()->misses, 2);
+}
+
+static void test_key_separation(void **state) {
+    (void) state;
+    uint8_t key1[KEY_LEN];
+    uint8_t key2[KEY_LEN];
+    uint8_t hash[CX_SHA256_SIZE];
+    uint8_t sig[2];
+    bool valid;
+
+    make_key(key1, 2);
+    make_key(key2, 3);
+    make_hash(hash, 0x20);
+    assert_true(verify(key1, hash, &valid));
+    assert_true(valid);
+    // same payload, signed with key1 but checked against key2
+    sig[0] = hash[0];
+    sig[1] = key1[0];
+    assert_false(sig_cache_verify(key2, KEY_LEN, hash, sizeof(hash), sig, sizeof(sig)));
+    assert_true(verify(key2, hash, &valid));
+    assert_true(valid);
+    assert_false(verify(key1, hash, &valid));
+    assert_false(verify(key2, hash, &valid));
+}
+
+static void test_round_robin_eviction(void **state) {
+    (void) state;
+    uint8_t key[KEY_LEN];
+    uint8_t hash[CX_SHA256_SIZE];
+    bool valid;
+
+    make_key(key, 4);
+    // fill the whole cache, the previous entries all get evicted
+    for (uint8_t i = 0; i < SIG_CACHE_SIZE; ++i) {
+        make_hash(hash, 0x30 + i);
+        assert_true(verify(key, hash, &valid));
+    }
+    make_hash(hash, 0x10);
+    key[0] = 1;
+    assert_true(verify(key, hash, &valid));
+    key[0] = 4;
+    // the oldest one made room for it, the others are still there
+    for (uint8_t i = 1; i < SIG_CACHE_SIZE; ++i) {
+        make_hash(hash, 0x30 + i);
+        assert_false(verify(key, hash, &valid));
+    }
+    make_hash(hash, 0x30);
+    assert_true(verify(key, hash, &valid));
+    assert_true(valid);
+}
+
+int main() {
+    const struct CMUnitTest tests[] = {
+        cmocka_unit_test(test_insert_and_hit),
+        cmocka_unit_test(test_key_separation),
+        cmocka_unit_test(test_round_robin_eviction),
+    };
+
+    return cmocka_run_group_tests(tests, NULL, NULL);
+}
@@ -0,0 +1,274 @@
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <cmocka.h>
+
+#include <string.h>
+
+#include "os.h"  // ARRAY_SIZE
+#include "eip712_schema.h"
+#include "mem.h"
+#include "typed_data.h"
+#include "type_hash.h"
+
+typedef struct {
+    const char *type;
+    const char *key;
+} field_def_t;
+
+typedef struct {
+    const char *name;
+    uint8_t fields_count;
+    const field_def_t *fields;
+    // encodeType of the struct, NULL if it cannot be hashed
+    const char *encoded;
+} struct_def_t;
+
+// Person & Group are used before being defined, Person refers to itself, Group to Person which
+// is already defined, & Missing is never defined
+static const field_def_t mail_fields[] = {
+    {"Person", "from"},
+    {"Person[]", "to"},
+    {"Group", "group"},
+    {"string", "contents"},
+    {"uint256", "amount"},
+    {"bytes32[2][]", "salts"},
+};
+static const field_def_t person_fields[] = {
+    {"string", "name"},
+    {"address", "wallet"},
+    {"Person[]", "friends"},
+};
+static const field_def_t group_fields[] = {
+    {"string", "name"},
+    {"Person", "owner"},
+};
+static const field_def_t orphan_fields[] = {
+    {"Missing[]", "missing"},
+    {"uint8", "value"},
+};
+
+#define PERSON_TYPE "Person(string name,address wallet,Person[] friends)"
+#define GROUP_TYPE  "Group(string name,Person owner)"
+
+static const struct_def_t structs[] = {
+    {"Mail",
+     ARRAY_SIZE(mail_fields),
+     mail_fields,
+     "Mail(Person from,Person[] to,Group group,string contents,uint256 amount,"
+     "bytes32[2][] salts)" GROUP_TYPE PERSON_TYPE},
+    {"Person", ARRAY_SIZE(person_fields), person_fields, PERSON_TYPE},
+    {"Group", ARRAY_SIZE(group_fields), group_fields, GROUP_TYPE PERSON_TYPE},
+    {"Orphan", ARRAY_SIZE(orphan_fields), orphan_fields, NULL},
+};
+
+// bytes saved by storing the forward references as ordinals : Mail.from, Mail.to & Mail.group
+#define COMPACTED_SIZE (strlen("Person") * 2 + strlen("Group"))
+
+static void define_structs(void) {
+    for (size_t sidx = 0; sidx < ARRAY_SIZE(structs); ++sidx) {
+        assert_true(eip712_schema_struct(structs[sidx].name));
+        for (uint8_t fidx = 0; fidx < structs[sidx].fields_count; ++fidx) {
+            assert_true(eip712_schema_field(structs[sidx].fields[fidx].type,
+                                            structs[sidx].fields[fidx].key));
+        }
+    }
+}
+
+static size_t structs_size(void) {
+    uint8_t structs_count;
+    const uint8_t *first = get_structs_array(&structs_count);
+    const uint8_t *ptr = first;
+
+    while (structs_count-- > 0) {
+        ptr = get_next_struct(ptr);
+    }
+    return ptr - first;
+}
+
+static size_t base_type_length(const char *type) {
+    const char *levels = strchr(type, '[');
+
+    return (levels != NULL) ? (size_t) (levels - type) : strlen(type);
+}
+
+// the field refers to a struct, by name
+static bool is_custom(const char *type) {
+    return (type[0] >= 'A') && (type[0] <= 'Z');
+}
+
+/**
+ * Check a custom-type field against the lookup of its struct by name
+ *
+ * @param[in] field_ptr the field
+ * @param[in] type its type, as it was defined
+ * @param[in] compacted whether the definitions got compacted
+ * @param[in] forward whether its struct was defined after it
+ */
+static void check_custom_field(const uint8_t *field_ptr,
+                               const char *type,
+                               bool compacted,
+                               bool forward) {
+    size_t length = base_type_length(type);
+    const uint8_t *by_name = get_structn(type, length);
+    uint8_t ordinal;
+    uint8_t ordinal_by_name;
+
+    assert_int_equal(struct_field_type(field_ptr), TYPE_CUSTOM);
+    assert_ptr_equal(get_struct_field_custom_struct(field_ptr), by_name);
+    if (by_name == NULL) {
+        // left as is
+        assert_int_equal(*field_ptr & (TYPENAME_ORDINAL_MASK | TYPENAME_RESOLVED_MASK), 0);
+        assert_false(get_struct_field_custom_ordinal(field_ptr, &ordinal));
+        return;
+    }
+    assert_true(get_struct_ordinal(by_name, &ordinal_by_name));
+    assert_true(get_struct_field_custom_ordinal(field_ptr, &ordinal));
+    assert_int_equal(ordinal, ordinal_by_name);
+    assert_ptr_equal(get_struct_from_ordinal(ordinal), by_name);
+    if (forward && !compacted) {
+        assert_int_equal(*field_ptr & (TYPENAME_ORDINAL_MASK | TYPENAME_RESOLVED_MASK),
+                         TYPENAME_RESOLVED_MASK);
+    } else {
+        assert_int_equal(*field_ptr & (TYPENAME_ORDINAL_MASK | TYPENAME_RESOLVED_MASK),
+                         TYPENAME_ORDINAL_MASK);
+    }
+}
+
+static void check_structs(bool compacted) {
+    uint8_t structs_count;
+    const uint8_t *struct_ptr = get_structs_array(&structs_count);
+    const uint8_t *field_ptr;
+    uint8_t fields_count;
+    const char *name;
+    uint8_t name_length;
+    uint8_t ordinal;
+    uint8_t lvls_count;
+
+    assert_int_equal(structs_count, ARRAY_SIZE(structs));
+    for (uint8_t sidx = 0; sidx < structs_count; ++sidx) {
+        const struct_def_t *def = &structs[sidx];
+
+        name = get_struct_name(struct_ptr, &name_length);
+        assert_int_equal(name_length, strlen(def->name));
+        assert_memory_equal(name, def->name, name_length);
+        assert_ptr_equal(get_structn(def->name, strlen(def->name)), struct_ptr);
+        assert_true(get_struct_ordinal(struct_ptr, &ordinal));
+        assert_int_equal(ordinal, sidx);
+        assert_ptr_equal(get_struct_from_ordinal(sidx), struct_ptr);
+
+        field_ptr = get_struct_fields_array(struct_ptr, &fields_count);
+        assert_int_equal(fields_count, def->fields_count);
+        for (uint8_t fidx = 0; fidx < fields_count; ++fidx) {
+            const field_def_t *field = &def->fields[fidx];
+            size_t type_length = base_type_length(field->type);
+
+            // whatever the way the type is stored, what follows is still found
+            name = get_struct_field_keyname(field_ptr, &name_length);
+            assert_int_equal(name_length, strlen(field->key));
+            assert_memory_equal(name, field->key, name_length);
+            assert_int_equal(struct_field_is_array(field_ptr),
+                             strchr(field->type, '[') != NULL);
+            if (struct_field_is_array(field_ptr)) {
+                get_struct_field_array_lvls_array(field_ptr, &lvls_count);
+                assert_int_equal(lvls_count, (strlen(field->type) - type_length + 1) / 3);
+            }
+            if (is_custom(field->type)) {
+                name = get_struct_field_custom_typename(field_ptr, &name_length);
+                assert_int_equal(name_length, type_length);
+                assert_memory_equal(name, field->type, type_length);
+                check_custom_field(field_ptr,
+                                   field->type,
+                                   compacted,
+                                   get_structn(field->type, type_length) > struct_ptr);
+            }
+            field_ptr = get_next_struct_field(field_ptr);
+        }
+        assert_ptr_equal(field_ptr, get_next_struct(struct_ptr));
+        struct_ptr = field_ptr;
+    }
+}
+
+static void check_type_hashes(void) {
+    uint8_t hash[32];
+    uint8_t expected[32];
+
+    for (size_t sidx = 0; sidx < ARRAY_SIZE(structs); ++sidx) {
+        const struct_def_t *def = &structs[sidx];
+
+        if (def->encoded == NULL) {
+            assert_false(type_hash(def->name, strlen(def->name), hash));
+        } else {
+            assert_true(type_hash(def->name, strlen(def->name), hash));
+            eip712_keccak(def->encoded, strlen(def->encoded), expected);
+            assert_memory_equal(hash, expected, sizeof(hash));
+        }
+    }
+}
+
+static int setup(void **state) {
+    (void) state;
+    eip712_schema_init();
+    return 0;
+}
+
+static int teardown(void **state) {
+    (void) state;
+    eip712_schema_deinit();
+    return 0;
+}
+
+static void test_compacted(void **state) {
+    (void) state;
+    size_t size;
+
+    define_structs();
+    size = structs_size();
+    assert_true(typed_data_build_index());
+    assert_int_equal(structs_size(), size - COMPACTED_SIZE);
+    check_structs(true);
+    check_type_hashes();
+}
+
+static void test_not_compacted(void **state) {
+    (void) state;
+    size_t size;
+
+    define_structs();
+    size = structs_size();
+    // the definitions are not at the top of the memory anymore
+    assert_non_null(mem_alloc(1));
+    assert_true(typed_data_build_index());
+    assert_int_equal(structs_size(), size);
+    check_structs(false);
+    check_type_hashes();
+}
+
+// the type names given by the client cannot set the internal TypeDesc flags
+static void test_internal_flags_cleared(void **state) {
+    (void) state;
+    const uint8_t field[] = {TYPE_CUSTOM | TYPENAME_ORDINAL_MASK | TYPENAME_RESOLVED_MASK,
+                             1,
+                             'A',
+                             1,
+                             'a'};
+    const uint8_t *field_ptr;
+    uint8_t fields_count;
+
+    assert_true(eip712_schema_struct("A"));
+    assert_true(set_struct_field(sizeof(field), field));
+    assert_true(typed_data_build_index());
+    field_ptr = get_struct_fields_array(get_structn("A", 1), &fields_count);
+    assert_int_equal(*field_ptr, TYPE_CUSTOM | TYPENAME_ORDINAL_MASK);
+    assert_ptr_equal(get_struct_field_custom_struct(field_ptr), get_structn("A", 1));
+}
+
+int main() {
+    const struct CMUnitTest tests[] = {
+        cmocka_unit_test_setup_teardown(test_compacted, setup, teardown),
+        cmocka_unit_test_setup_teardown(test_not_compacted, setup, teardown),
+        cmocka_unit_test_setup_teardown(test_internal_flags_cleared, setup, teardown),
+    };
+
+    return cmocka_run_group_tests(tests, NULL, NULL);
+}
@@ -0,0 +1,198 @@
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <cmocka.h>
+
+#include <stdlib.h>
+
+#include "uint256.h"
+#include "uint_common.h"
+
+__extension__ typedef unsigned __int128 native_u128_t;
+
+static uint64_t rand64(void) {
+    return ((uint64_t) rand() << 62) ^ ((uint64_t) rand() << 31) ^ (uint64_t) rand();
+}
+
+// random number with a random amount of significant bits
+static void rand256(uint256_t *number) {
+    uint32_t bits = rand() % 257;
+
+    UPPER(UPPER_P(number)) = rand64();
+    LOWER(UPPER_P(number)) = rand64();
+    UPPER(LOWER_P(number)) = rand64();
+    LOWER(LOWER_P(number)) = rand64();
+    shiftr256(number, 256 - bits, number);
+}
+
+static void test_divmod128(void **state) {
+    (void) state;
+    uint128_t l, r, q, m;
+
+    srand(128);
+    for (int i = 0; i < 100000; ++i) {
+        native_u128_t a = ((native_u128_t) rand64() << 64) | rand64();
+        native_u128_t b = ((native_u128_t) rand64() << 64) | rand64();
+
+        a >>= rand() % 128;
+        b >>= rand() % 128;
+        if (b == 0) {
+            continue;
+        }
+        UPPER(l) = a >> 64;
+        LOWER(l) = a;
+        UPPER(r) = b >> 64;
+        LOWER(r) = b;
+        divmod128(&l, &r, &q, &m);
+        assert_true(UPPER(q) == (uint64_t) ((a / b) >> 64));
+        assert_true(LOWER(q) == (uint64_t) (a / b));
+        assert_true(UPPER(m) == (uint64_t) ((a % b) >> 64));
+        assert_true(LOWER(m) == (uint64_t) (a % b));
+    }
+}
+
+static void test_divmod256(void **state) {
+    (void) state;
+    uint256_t l, r, q, m, check;
+
+    srand(256);
+    for (int i = 0; i < 100000; ++i) {
+        rand256(&l);
+        rand256(&r);
+        if (zero256(&r)) {
+            continue;
+        }
+        divmod256(&l, &r, &q, &m);
+        // l == q * r + m, with m < r
+        assert_true(gt256(&r, &m));
+        mul256(&q, &r, &check);
+        add256(&check, &m, &check);
+        assert_true(equal256(&check, &l));
+    }
+}
+
+static void test_divmod256_aliasing(void **state) {
+    (void) state;
+    uint256_t l, r, m;
+
+    clear256(&l);
+    clear256(&r);
+    LOWER(LOWER(l)) = 1000;
+    LOWER(LOWER(r)) = 7;
+    divmod256(&l, &r, &l, &m);
+    assert_int_equal(LOWER(LOWER(l)), 142);
+    assert_int_equal(LOWER(LOWER(m)), 6);
+}
+
+static void test_tostring256(void **state) {
+    (void) state;
+    uint256_t number;
+    char out[80];
+
+    clear256(&number);
+    assert_true(tostring256(&number, 10, out, sizeof(out)));
+    assert_string_equal(out, "0");
+
+    memset(&number, 0xff, sizeof(number));
+    assert_true(tostring256(&number, 10, out, sizeof(out)));
+    assert_string_equal(
+        out,
+        "115792089237316195423570985008687907853269984665640564039457584007913129639935");
+    assert_true(tostring256(&number, 16, out, sizeof(out)));
+    assert_string_equal(out, "ffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffff");
+    assert_false(tostring256(&number, 10, out, 78));
+    assert_string_equal(out, "...");
+
+    assert_true(tostring256_signed(&number, 10, out, sizeof(out)));
+    assert_string_equal(out, "-1");
+
+    clear256(&number);
+    UPPER(UPPER(number)) = 0x8000000000000000;
+    assert_true(tostring256_signed(&number, 10, out, sizeof(out)));
+    assert_string_equal(
+        out,
+        "-57896044618658097711785492504343953926634992332820282019728792003956564819968");
+}
+
+static void test_tostring128(void **state) {
+    (void) state;
+    uint128_t number;
+    char out[48];
+
+    UPPER(number) = 0x8000000000000000;
+    LOWER(number) = 0;
+    assert_true(tostring128(&number, 10, out, sizeof(out)));
+    assert_string_equal(out, "170141183460469231731687303715884105728");
+    assert_true(tostring128_signed(&number, 10, out, sizeof(out)));
+    assert_string_equal(out, "-170141183460469231731687303715884105728");
+
+    UPPER(number) = 0;
+    LOWER(number) = 1234567890;
+    assert_true(tostring128_signed(&number, 10, out, sizeof(out)));
+    assert_string_equal(out, "1234567890");
+    assert_false(tostring128(&number, 10, out, 10));
+}
+
+static void set_u64(uint256_t *number, uint64_t value) {
+    clear256(number);
+    LOWER(LOWER_P(number)) = value;
+}
+
+static void test_u256_to_decimal(void **state) {
+    (void) state;
+    uint256_t number;
+    char out[100];
+
+    set_u64(&number, 0);
+    assert_true(u256_to_decimal(&number, 0, out, sizeof(out)));
+    assert_string_equal(out, "0");
+    assert_true(u256_to_decimal(&number, 18, out, sizeof(out)));
+    assert_string_equal(out, "0");
+
+    set_u64(&number, 1000000000);
+    assert_true(u256_to_decimal(&number, 0, out, sizeof(out)));
+    assert_string_equal(out, "1000000000");
+    assert_true(u256_to_decimal(&number, 9, out, sizeof(out)));
+    assert_string_equal(out, "1");
+
+    set_u64(&number, 1500000000000000000);
+    assert_true(u256_to_decimal(&number, 18, out, sizeof(out)));
+    assert_string_equal(out, "1.5");
+
+    set_u64(&number, 21000);
+    assert_true(u256_to_decimal(&number, 18, out, sizeof(out)));
+    assert_string_equal(out, "0.000000000000021");
+    assert_true(u256_to_decimal(&number, 2, out, sizeof(out)));
+    assert_string_equal(out, "210");
+    assert_true(u256_to_decimal(&number, 5, out, sizeof(out)));
+    assert_string_equal(out, "0.21");
+
+    set_u64(&number, 123000000456);
+    assert_true(u256_to_decimal(&number, 6, out, sizeof(out)));
+    assert_string_equal(out, "123000.000456");
+    // exactly fits, then one byte short
+    assert_true(u256_to_decimal(&number, 6, out, 14));
+    assert_false(u256_to_decimal(&number, 6, out, 13));
+
+    memset(&number, 0xff, sizeof(number));
+    assert_true(u256_to_decimal(&number, 18, out, sizeof(out)));
+    assert_string_equal(
+        out,
+        "115792089237316195423570985008687907853269984665640564039457.584007913129639935");
+    assert_true(u256_to_decimal(&number, 80, out, sizeof(out)));
+    assert_string_equal(
+        out,
+        "0.00115792089237316195423570985008687907853269984665640564039457584007913129639935");
+}
+
+int main(void) {
+    const struct CMUnitTest tests[] = {
+        cmocka_unit_test(test_divmod128),
+        cmocka_unit_test(test_divmod256),
+        cmocka_unit_test(test_divmod256_aliasing),
+        cmocka_unit_test(test_tostring256),
+        cmocka_unit_test(test_tostring128),
+        cmocka_unit_test(test_u256_to_decimal),
+    };
+    return cmocka_run_group_tests(tests, NULL, NULL);
+}
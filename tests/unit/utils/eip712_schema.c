@@ -0,0 +1,121 @@
+#include <stdlib.h>
+#include <string.h>
+
+#include "eip712_schema.h"
+#include "cx.h"
+#include "mem.h"
+#include "sol_typenames.h"
+#include "typed_data.h"
+#include "type_hash.h"
+#include "path.h"
+#include "context_712.h"
+#include "shared_context.h"
+
+// app globals the modules under test rely on
+uint16_t apdu_response_code;
+e_struct_init struct_state;
+tmpCtx_t tmpCtx;
+cx_sha3_t global_sha3;
+
+// called by the path module whenever the current field changes
+void ui_712_notify_filter_change(void) {
+}
+
+void eip712_schema_init(void) {
+    mem_init();
+    if (!sol_typenames_init() || !path_init() || !typed_data_init()) {
+        abort();
+    }
+    struct_state = NOT_INITIALIZED;
+}
+
+void eip712_schema_deinit(void) {
+    typed_data_deinit();
+    type_hash_deinit();
+    path_deinit();
+    mem_reset();
+}
+
+bool eip712_schema_struct(const char *name) {
+    return set_struct_name(strlen(name), (const uint8_t *) name);
+}
+
+static bool type_is(const char *type, size_t length, const char *name) {
+    return (length == strlen(name)) && (strncmp(type, name, length) == 0);
+}
+
+static bool parse_sized_type(const char *type,
+                             size_t length,
+                             const char *prefix,
+                             uint16_t *typesize) {
+    size_t prefix_length = strlen(prefix);
+
+    if ((length <= prefix_length) || (strncmp(type, prefix, prefix_length) != 0)) {
+        return false;
+    }
+    *typesize = (uint16_t) strtoul(&type[prefix_length], NULL, 10);
+    return true;
+}
+
+bool eip712_schema_field(const char *type, const char *key) {
+    uint8_t data[255];
+    uint8_t length = 1;
+    const char *levels = strchr(type, '[');
+    size_t base_length = (levels != NULL) ? (size_t) (levels - type) : strlen(type);
+    uint16_t typesize;
+
+    if (type_is(type, base_length, "address")) {
+        data[0] = TYPE_SOL_ADDRESS;
+    } else if (type_is(type, base_length, "bool")) {
+        data[0] = TYPE_SOL_BOOL;
+    } else if (type_is(type, base_length, "string")) {
+        data[0] = TYPE_SOL_STRING;
+    } else if (type_is(type, base_length, "bytes")) {
+        data[0] = TYPE_SOL_BYTES_DYN;
+    } else if (parse_sized_type(type, base_length, "bytes", &typesize)) {
+        data[0] = TYPE_SOL_BYTES_FIX | TYPESIZE_MASK;
+        data[length++] = typesize;
+    } else if (parse_sized_type(type, base_length, "uint", &typesize)) {
+        data[0] = TYPE_SOL_UINT | TYPESIZE_MASK;
+        data[length++] = typesize / 8;
+    } else if (parse_sized_type(type, base_length, "int", &typesize)) {
+        data[0] = TYPE_SOL_INT | TYPESIZE_MASK;
+        data[length++] = typesize / 8;
+    } else {
+        data[0] = TYPE_CUSTOM;
+        data[length++] = base_length;
+        memcpy(&data[length], type, base_length);
+        length += base_length;
+    }
+    if (levels != NULL) {
+        uint8_t *levels_count = &data[length++];
+
+        data[0] |= ARRAY_MASK;
+        *levels_count = 0;
+        while (*levels == '[') {
+            if (levels[1] == ']') {
+                data[length++] = ARRAY_DYNAMIC;
+            } else {
+                data[length++] = ARRAY_FIXED_SIZE;
+                data[length++] = (uint8_t) strtoul(&levels[1], NULL, 10);
+            }
+            levels = strchr(levels, ']') + 1;
+            *levels_count += 1;
+        }
+    }
+    data[length++] = strlen(key);
+    memcpy(&data[length], key, strlen(key));
+    length += strlen(key);
+    return set_struct_field(length, data);
+}
+
+void eip712_keccak(const void *data, size_t length, uint8_t hash[32]) {
+    cx_sha3_t ctx;
+
+    cx_keccak_init_no_throw(&ctx, 256);
+    cx_hash_no_throw((cx_hash_t *) &ctx, CX_LAST, data, length, hash, 32);
+}
+
+const uint8_t *eip712_schema_message_hash(void) {
+    return tmpCtx.messageSigningContext712.messageHash;
+}
@@ -0,0 +1,28 @@
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * Set up the EIP-712 typed data & path modules the way eip712_context_init does,
+ * without the field hashing & the UI
+ */
+void eip712_schema_init(void);
+void eip712_schema_deinit(void);
+
+/**
+ * Define a struct / one of its fields, the way the struct definition APDUs do
+ *
+ * The field type is given as in the EIP-712 JSON types, e.g. "uint256", "bytes32[2][]" or
+ * "Person[]".
+ */
+bool eip712_schema_struct(const char *name);
+bool eip712_schema_field(const char *type, const char *key);
+
+void eip712_keccak(const void *data, size_t length, uint8_t hash[32]);
+
+/**
+ * Hash of the message, once all its values have been received
+ */
+const uint8_t *eip712_schema_message_hash(void);
@@ -0,0 +1,207 @@
+#include <string.h>
+
+#include "tx_corpus.h"
+
+typedef struct rlp_writer_s {
+    uint8_t *buffer;
+    size_t length;
+} rlp_writer_t;
+
+static size_t be_length(uint64_t value) {
+    size_t length = 0;
+
+    while (value != 0) {
+        length += 1;
+        value >>= 8;
+    }
+    return length;
+}
+
+static void write_be(uint8_t *out, uint64_t value, size_t length) {
+    for (size_t i = 0; i < length; ++i) {
+        out[length - 1 - i] = (uint8_t) (value >> (8 * i));
+    }
+}
+
+static size_t rlp_header(uint8_t *out, size_t length, uint8_t short_base, uint8_t long_base) {
+    if (length <= 55) {
+        out[0] = short_base + length;
+        return 1;
+    }
+    out[0] = long_base + be_length(length);
+    write_be(out + 1, length, be_length(length));
+    return 1 + be_length(length);
+}
+
+static void rlp_bytes(rlp_writer_t *w, const uint8_t *data, size_t length) {
+    if ((length == 1) && (data[0] <= 0x7f)) {
+        w->buffer[w->length++] = data[0];
+        return;
+    }
+    w->length += rlp_header(w->buffer + w->length, length, 0x80, 0xb7);
+    memcpy(w->buffer + w->length, data, length);
+    w->length += length;
+}
+
+static void rlp_uint(rlp_writer_t *w, uint64_t value) {
+    uint8_t tmp[8] = {0};
+    size_t length = be_length(value);
+
+    write_be(tmp, value, length);
+    rlp_bytes(w, tmp, length);
+}
+
+// Wraps everything written since start into a list
+static void rlp_list_close(rlp_writer_t *w, size_t start) {
+    uint8_t header[9];
+    size_t payload = w->length - start;
+    size_t header_length = rlp_header(header, payload, 0xc0, 0xf7);
+
+    memmove(w->buffer + start + header_length, w->buffer + start, payload);
+    memcpy(w->buffer + start, header, header_length);
+    w->length += header_length;
+}
+
+static void fill_pattern(uint8_t *out, size_t length, uint8_t seed) {
+    for (size_t i = 0; i < length; ++i) {
+        out[i] = (uint8_t) (seed + i * 7);
+    }
+}
+
+static void rlp_access_list(rlp_writer_t *w, size_t addresses, size_t keys) {
+    size_t list_start = w->length;
+    uint8_t tmp[32];
+
+    for (size_t a = 0; a < addresses; ++a) {
+        size_t entry_start = w->length;
+        size_t keys_start;
+
+        fill_pattern(tmp, 20, (uint8_t) (0x40 + a));
+        rlp_bytes(w, tmp, 20);
+        keys_start = w->length;
+        for (size_t k = 0; k < keys; ++k) {
+            fill_pattern(tmp, 32, (uint8_t) (0x80 + k));
+            rlp_bytes(w, tmp, 32);
+        }
+        rlp_list_close(w, keys_start);
+        rlp_list_close(w, entry_start);
+    }
+    rlp_list_close(w, list_start);
+}
+
+typedef struct tx_corpus_spec_s {
+    const char *name;
+    uint8_t type;
+    uint64_t chain_id;
+    size_t data_length;
+    size_t access_list_addresses;
+    size_t access_list_keys;
+} tx_corpus_spec_t;
+
+static const tx_corpus_spec_t g_specs[] = {
+    {"legacy transfer", LEGACY, 1, 0, 0, 0},
+    {"legacy erc20 transfer", LEGACY, 56, 68, 0, 0},
+    {"legacy 2k calldata", LEGACY, 137, 2048, 0, 0},
+    {"eip2930 transfer", EIP2930, 1, 0, 1, 2},
+    {"eip2930 1k calldata", EIP2930, 10, 1024, 3, 4},
+    {"eip1559 transfer", EIP1559, 1, 0, 0, 0},
+    {"eip1559 erc20 transfer", EIP1559, 42161, 68, 0, 0},
+    {"eip1559 3k calldata", EIP1559, 1, 3000, 2, 3},
+};
+
+size_t tx_corpus_count(void) {
+    return sizeof(g_specs) / sizeof(g_specs[0]);
+}
+
+void tx_corpus_build(size_t index, tx_corpus_entry_t *entry) {
+    const tx_corpus_spec_t *spec = &g_specs[index];
+    rlp_writer_t w;
+    uint8_t data[TX_CORPUS_MAX_SIZE];
+
+    memset(entry, 0, sizeof(*entry));
+    entry->name = spec->name;
+    entry->type = spec->type;
+    entry->chain_id = spec->chain_id;
+    entry->nonce = 42 + index;
+    entry->value = 1000000000000000000ULL + index;
+    fill_pattern(entry->to, sizeof(entry->to), (uint8_t) index);
+    entry->data_length = spec->data_length;
+    fill_pattern(data, spec->data_length, 0x11);
+
+    w.buffer = entry->buffer;
+    w.length = 0;
+    if (spec->type != LEGACY) {
+        w.buffer[w.length++] = spec->type;
+    }
+    size_t list_start = w.length;
+    if (spec->type != LEGACY) {
+        rlp_uint(&w, spec->chain_id);
+    }
+    rlp_uint(&w, entry->nonce);
+    if (spec->type == EIP1559) {
+        rlp_uint(&w, 1500000000);  // max priority fee per gas
+    }
+    rlp_uint(&w, 30000000000);  // gas price / max fee per gas
+    rlp_uint(&w, 21000 + 16 * spec->data_length);
+    rlp_bytes(&w, entry->to, sizeof(entry->to));
+    rlp_uint(&w, entry->value);
+    rlp_bytes(&w, data, spec->data_length);
+    if (spec->type == LEGACY) {
+        // EIP-155 signing payload : v = chain ID, r = s = 0
+        entry->vrs_offset = w.length;
+        rlp_uint(&w, spec->chain_id);
+        rlp_uint(&w, 0);
+        rlp_uint(&w, 0);
+    } else {
+        rlp_access_list(&w, spec->access_list_addresses, spec->access_list_keys);
+    }
+    size_t before_close = w.length;
+    rlp_list_close(&w, list_start);
+    if (entry->vrs_offset != 0) {
+        // account for the list header inserted in front
+        entry->vrs_offset += w.length - before_close;
+    }
+    entry->length = w.length;
+}
+
+bool tx_corpus_parse(const tx_corpus_entry_t *entry,
+                     size_t chunk_size,
+                     txContext_t *context,
+                     txContent_t *content,
+                     uint8_t hash[32]) {
+    static cx_sha3_t sha3;
+    const uint8_t *buffer = entry->buffer;
+    size_t remaining = entry->length;
+    size_t offset = 0;
+    parserStatus_e status = USTREAM_PROCESSING;
+
+    memset(content, 0, sizeof(*content));
+    initTx(context, &sha3, content, NULL, NULL);
+    if (entry->type != LEGACY) {
+        cx_hash_no_throw((cx_hash_t *) &sha3, 0, buffer, 1, NULL, 0);
+        context->txType = entry->type;
+        offset = 1;
+    } else {
+        context->txType = LEGACY;
+    }
+    remaining -= offset;
+    while (remaining > 0) {
+        size_t length = MIN(remaining, chunk_size);
+
+        // Same as the client libraries : never split the v,r,s fields of a legacy transaction
+        if ((entry->vrs_offset != 0) && ((offset + length) >= entry->vrs_offset)) {
+            length = remaining;
+        }
+        status = processTx(context, buffer + offset, length, 0);
+        offset += length;
+        remaining -= length;
+        if ((status != USTREAM_PROCESSING) && (remaining > 0)) {
+            return false;
+        }
+    }
+    if (status != USTREAM_FINISHED) {
+        return false;
+    }
+    cx_hash_no_throw((cx_hash_t *) &sha3, CX_LAST, NULL, 0, hash, 32);
+    return true;
+}
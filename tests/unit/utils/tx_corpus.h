@@ -0,0 +1,43 @@
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "ethUstream.h"
+
+#define TX_CORPUS_MAX_SIZE 4096
+
+typedef struct tx_corpus_entry_s {
+    const char *name;
+    uint8_t type;  // EIP-2718 type byte, LEGACY when not a typed transaction
+    uint8_t buffer[TX_CORPUS_MAX_SIZE];
+    size_t length;
+    size_t vrs_offset;  // start of the trailing v,r,s fields of a legacy transaction, 0 otherwise
+    // expected parsed values
+    uint64_t chain_id;
+    uint64_t nonce;
+    uint64_t value;
+    uint8_t to[20];
+    size_t data_length;
+} tx_corpus_entry_t;
+
+size_t tx_corpus_count(void);
+void tx_corpus_build(size_t index, tx_corpus_entry_t *entry);
+
+/**
+ * Stream a transaction through processTx/continueTx the way cmd_signTx does it,
+ * with APDUs of at most chunk_size bytes
+ *
+ * @param[in] entry the transaction
+ * @param[in] chunk_size maximum APDU payload size
+ * @param[out] context parser context, left in its final state
+ * @param[out] content parsed transaction content
+ * @param[out] hash Keccak-256 of the transaction as computed by the parser
+ * @return whether the parser reported USTREAM_FINISHED after the last APDU
+ */
+bool tx_corpus_parse(const tx_corpus_entry_t *entry,
+                     size_t chunk_size,
+                     txContext_t *context,
+                     txContent_t *content,
+                     uint8_t hash[32]);
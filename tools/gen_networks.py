@@ -85,6 +85,84 @@ def gen_icons_array(networks: list[Network], path: str) -> bool:
     return True
 
 
+def gen_string_pool(strings: list[str]) -> tuple[str, dict[str, int]]:
+    pool = ""
+    offsets: dict[str, int] = dict()
+
+    # longest first, so that a string ending another one can reuse its tail
+    for string in sorted(set(strings), key=lambda x: (-len(x), x)):
+        idx = pool.find(string + "\0")
+        if idx == -1:
+            idx = len(pool)
+            pool += string + "\0"
+        offsets[string] = idx
+    return pool, offsets
+
+
+def gen_table_inc(networks: list[Network], pool: str, path: str) -> bool:
+    with open(path + ".h", "w") as out:
+        print(get_header() + """\
+#ifndef NETWORK_TABLE_GENERATED_H_
+#define NETWORK_TABLE_GENERATED_H_
+
+#include <stdint.h>
+
+#define NETWORK_COUNT %u
+
+// sorted in ascending order
+extern const uint64_t g_network_chain_ids[NETWORK_COUNT];
+// offsets in g_network_strings
+extern const uint16_t g_network_names[NETWORK_COUNT];
+extern const uint16_t g_network_tickers[NETWORK_COUNT];
+extern const char g_network_strings[%u];
+
+#endif // NETWORK_TABLE_GENERATED_H_ \
+""" % (len(networks), len(pool)), file=out)
+    return True
+
+
+def gen_table_src(networks: list[Network],
+                  pool: str,
+                  offsets: dict[str, int],
+                  path: str) -> bool:
+    with open(path + ".c", "w") as out:
+        print(get_header() + """\
+#include "%s.h"
+""" % (os.path.basename(path)), file=out)
+
+        print("const uint64_t g_network_chain_ids[NETWORK_COUNT] = {", file=out)
+        for net in networks:
+            print(" "*4 + "%u, // %s" % (net.chain_id, net.name), file=out)
+        print("};\n", file=out)
+
+        for array, attr in (("g_network_names", "name"),
+                            ("g_network_tickers", "ticker")):
+            print("const uint16_t %s[NETWORK_COUNT] = {" % (array), file=out)
+            for net in networks:
+                string = getattr(net, attr)
+                print(" "*4 + "%u, // %s" % (offsets[string], string), file=out)
+            print("};\n", file=out)
+
+        print("const char g_network_strings[%u] =" % (len(pool)), file=out)
+        strings = pool.split("\0")[:-1]
+        for idx, string in enumerate(strings):
+            end = ";" if idx == (len(strings) - 1) else ""
+            print(" "*4 + "\"%s\\0\"%s" % (string, end), file=out)
+    return True
+
+
+def gen_table(networks: list[Network], path: str) -> bool:
+    path += "/net_table.gen"
+    strings = [net.name for net in networks] + [net.ticker for net in networks]
+    pool, offsets = gen_string_pool(strings)
+    # offsets have to fit in the generated uint16_t arrays
+    assert len(pool) <= 0xffff
+    if not gen_table_inc(networks, pool, path) or \
+       not gen_table_src(networks, pool, offsets, path):
+        return False
+    return True
+
+
 def network_icon_exists(net: Network) -> bool:
     return os.path.isfile("glyphs/%s.gif" % (get_network_glyph_name(net)))
 
@@ -94,7 +172,7 @@ def main(output_dir: str) -> bool:
 
     # get chain IDs and network names
     expr = r"{\.chain_id = ([0-9]*), \.name = \"(.*)\", \.ticker = \"(.*)\"},"
-    with open("src/network.c") as f:
+    with open("src/networks.def") as f:
         for line in f.readlines():
             line = line.strip()
             if line.startswith("{") and line.endswith("},"):
@@ -106,6 +184,12 @@ def main(output_dir: str) -> bool:
                                         m.group(3)))
 
     networks.sort(key=lambda x: x.chain_id)
+    for prev, net in zip(networks, networks[1:]):
+        assert prev.chain_id != net.chain_id, \
+            "chain ID %u is defined twice" % (net.chain_id)
+
+    if not gen_table(networks, output_dir):
+        return False
 
     if not gen_icons_array(list(filter(network_icon_exists, networks)),
                            output_dir):